@@ -41,6 +41,8 @@ namespace Slic3r::CLI
     // Implemented in Setup.cpp
 
     bool    setup(Data& cli, int argc, char** argv);
+            // parse the command line arguments into cli, argv[0] is skipped
+    bool    read_args(Data& cli, int argc, const char* const argv[]);
 
     // Implemented in LoadPrintData.cpp
 
@@ -61,6 +63,11 @@ namespace Slic3r::CLI
     bool    process_profiles_sharing(const Data& cli);
     bool    process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vector<Model>& models);
 
+    // Implemented in Server.cpp
+
+            // process the jobs read from stdin until its end, see the "server" action
+    int     run_server(const Data& cli);
+
     // Implemented in GuiParams.cpp
 #ifdef SLIC3R_GUI
             // set data for init GUI parameters
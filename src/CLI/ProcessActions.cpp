@@ -280,7 +280,7 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
     if (actions.has("info")) {
         if (models.empty()) {
             boost::nowide::cerr << "error: cannot show info for empty models." << std::endl;
-            return 1;
+            return false;
         }
         // --info works on unrepaired model
         for (Model& model : models) {
@@ -297,7 +297,7 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
 
     if (models.empty() && (actions.has("export_stl") || actions.has("export_obj") || actions.has("export_3mf"))) {
         boost::nowide::cerr << "error: cannot export empty models." << std::endl;
-        return 1;
+        return false;
     }
 
     const std::string output = cli.misc_config.has("output") ? cli.misc_config.opt_string("output") : "";
@@ -306,28 +306,28 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
         for (auto& model : models)
             model.add_default_instances();
         if (!export_models(models, IO::STL, output))
-            return 1;
+            return false;
     }
     if (actions.has("export_obj")) {
         for (auto& model : models)
             model.add_default_instances();
         if (!export_models(models, IO::OBJ, output))
-            return 1;
+            return false;
     }
     if (actions.has("export_3mf")) {
         if (!export_models(models, IO::TMF, output))
-            return 1;
+            return false;
     }
 
     if (actions.has("slice") || actions.has("export_gcode") || actions.has("export_sla")) {
         PrinterTechnology       printer_technology = Preset::printer_technology(print_config);
         if (actions.has("export_gcode") && printer_technology == ptSLA) {
             boost::nowide::cerr << "error: cannot export G-code for an FFF configuration" << std::endl;
-            return 1;
+            return false;
         }
         else if (actions.has("export_sla") && printer_technology == ptFFF) {
             boost::nowide::cerr << "error: cannot export SLA slices for a SLA configuration" << std::endl;
-            return 1;
+            return false;
         }
 
         const Vec2crd           gap{ s_multiple_beds.get_bed_gap() };
@@ -335,6 +335,8 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
         arr2::ArrangeSettings   arrange_cfg;
         arrange_cfg.set_distance_from_objects(min_object_distance(print_config));
 
+        const std::string profile_trace = cli.misc_config.has("profile_trace") ? cli.misc_config.opt_string("profile_trace") : std::string();
+
         for (Model& model : models) {
             // If all objects have defined instances, their relative positions will be
             // honored when printing (they will be only centered, unless --dont-arrange
@@ -359,6 +361,7 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
             });
 
             PrintBase* print = (printer_technology == ptFFF) ? static_cast<PrintBase*>(&fff_print) : static_cast<PrintBase*>(&sla_print);
+            print->profiler().enable(!profile_trace.empty());
             if (printer_technology == ptFFF) {
                 for (auto* mo : model.objects)
                     fff_print.auto_assign_extruders(mo);
@@ -373,7 +376,7 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
             std::string err = print->validate();
             if (!err.empty()) {
                 boost::nowide::cerr << err << std::endl;
-                return 1;
+                return false;
             }
 
             std::string outfile = output;
@@ -406,6 +409,16 @@ bool process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vec
                 // Run the post-processing scripts if defined.
                 run_post_process_scripts(outfile, fff_print.full_print_config());
                 boost::nowide::cout << "Slicing result exported to " << outfile << std::endl;
+                if (!profile_trace.empty()) {
+                    // With multiple models, the traces are numbered in the order of the models.
+                    std::string trace_file = profile_trace;
+                    if (models.size() > 1) {
+                        boost::filesystem::path path(profile_trace);
+                        trace_file = (path.parent_path() / (path.stem().string() + "_" + std::to_string(&model - models.data() + 1) + path.extension().string())).string();
+                    }
+                    print->profiler().export_chrome_trace(trace_file);
+                    boost::nowide::cout << "Profile trace exported to " << trace_file << std::endl;
+                }
             }
             catch (const std::exception& ex) {
                 boost::nowide::cerr << ex.what() << std::endl;
@@ -13,6 +13,9 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <memory>
+#include <mutex>
+
 namespace Slic3r {
 
 static bool load_preset_bundle_from_datadir(PresetBundle& preset_bundle)
@@ -80,6 +83,30 @@ static bool load_preset_bundle_from_datadir(PresetBundle& preset_bundle)
     return true;
 }
 
+// Profiles used by load_full_print_config() are loaded from the datadir once and kept for the lifetime of the process,
+// so that the jobs of the CLI server mode do not load them again. load_full_print_config() selects presets in the bundle,
+// thus access to the bundle is serialized.
+static std::mutex                    s_preset_bundle_mutex;
+static std::unique_ptr<PresetBundle> s_preset_bundle;
+
+// To be called with s_preset_bundle_mutex locked.
+static PresetBundle* shared_preset_bundle()
+{
+    if (! s_preset_bundle) {
+        auto preset_bundle = std::make_unique<PresetBundle>();
+        if (! load_preset_bundle_from_datadir(*preset_bundle))
+            return nullptr;
+        s_preset_bundle = std::move(preset_bundle);
+    }
+    return s_preset_bundle.get();
+}
+
+bool preload_preset_bundle()
+{
+    std::scoped_lock<std::mutex> lock(s_preset_bundle_mutex);
+    return shared_preset_bundle() != nullptr;
+}
+
 namespace pt = boost::property_tree;
 /*
 struct PrinterAttr_
@@ -419,11 +446,13 @@ std::string get_json_print_filament_profiles(const std::string& printer_profile)
 // Helper function for FS
 bool load_full_print_config(const std::string& print_preset_name, const std::string& filament_preset_name, const std::string& printer_preset_name, DynamicPrintConfig& config)
 {
-    PresetBundle preset_bundle;
-    if (!load_preset_bundle_from_datadir(preset_bundle)){
+    std::scoped_lock<std::mutex> lock(s_preset_bundle_mutex);
+    PresetBundle* preset_bundle_ptr = shared_preset_bundle();
+    if (!preset_bundle_ptr) {
         BOOST_LOG_TRIVIAL(error) << Slic3r::format("Failed to load data from the datadir '%1%'.", data_dir());
         return false;
     }
+    PresetBundle& preset_bundle = *preset_bundle_ptr;
 
     config = {};
     config.apply(FullPrintConfig::defaults());
@@ -470,9 +499,11 @@ std::string load_full_print_config(const std::string& print_preset_name,
 
     // check preset bundle
 
-    PresetBundle preset_bundle;
-    if (!load_preset_bundle_from_datadir(preset_bundle))
+    std::scoped_lock<std::mutex> lock(s_preset_bundle_mutex);
+    PresetBundle* preset_bundle_ptr = shared_preset_bundle();
+    if (!preset_bundle_ptr)
         return Slic3r::format("Failed to load data from the datadir '%1%'.", data_dir());
+    PresetBundle& preset_bundle = *preset_bundle_ptr;
 
     // check existance of required profiles
 
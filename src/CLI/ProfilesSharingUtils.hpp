@@ -14,6 +14,10 @@ std::string get_json_printer_models(PrinterTechnology printer_technology);
 //std::string get_json_printer_profiles(const std::string& printer_model, const std::string& printer_variant);
 std::string get_json_print_filament_profiles(const std::string& printer_profile);
 
+// Load the installed profiles from the datadir ahead of calling load_full_print_config(), which keeps them loaded
+// for the lifetime of the process. Returns false if the profiles could not be loaded.
+bool preload_preset_bundle();
+
 class DynamicPrintConfig;
 bool load_full_print_config(const std::string& print_preset, const std::string& filament_preset, const std::string& printer_preset, DynamicPrintConfig& out_config);
 
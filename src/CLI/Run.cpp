@@ -9,6 +9,9 @@ int run(int argc, char** argv)
     if (!setup(cli, argc, argv))
         return 1;
 
+    if (cli.actions_config.has("server"))
+        return run_server(cli);
+
     if (process_profiles_sharing(cli))
         return 1;
 
@@ -0,0 +1,189 @@
+#include <cerrno>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "libslic3r/libslic3r.h"
+#include "libslic3r/Config.hpp"
+#include "libslic3r/Model.hpp"
+#include "libslic3r/Utils.hpp"
+
+#include "CLI/CLI.hpp"
+#include "CLI/ProfilesSharingUtils.hpp"
+#include "CLI/ServerJob.hpp"
+
+namespace Slic3r::CLI {
+
+namespace pt = boost::property_tree;
+
+static void write_result(const std::string& id, bool success, const std::string& message)
+{
+    pt::ptree tree;
+    tree.put("id", id);
+    tree.put("status", success ? "ok" : "error");
+    if (!message.empty())
+        tree.put("message", message);
+    std::ostringstream os;
+    pt::write_json(os, tree, false);
+    // write_json() terminates the output with a new line.
+    boost::nowide::cout << os.str() << std::flush;
+}
+
+// Process a single job the same way run() processes the command line.
+// Errors are reported to stderr.
+static bool run_job(const Data& server_cli, const ServerJob& job)
+{
+    std::vector<const char*> argv { SLIC3R_APP_KEY };
+    for (const std::string& arg : job.args)
+        argv.emplace_back(arg.c_str());
+
+    Data cli;
+    if (!read_args(cli, int(argv.size()), argv.data()))
+        return false;
+    cli.overrides_config.apply(job.config, true);
+    if (cli.actions_config.has("server") || cli.actions_config.has("gcodeviewer")) {
+        boost::nowide::cerr << "The server and the G-code viewer cannot be started from a server job." << std::endl;
+        return false;
+    }
+    // The data directory was set by the server command line for the whole process, the profiles are preloaded from it.
+    if (cli.misc_config.has("datadir") && cli.misc_config.opt_string("datadir") != data_dir()) {
+        boost::nowide::cerr << "The data directory cannot be changed by a server job, use --datadir of the server." << std::endl;
+        return false;
+    }
+    // The configuration files loaded by the server command line apply to all jobs, they are loaded before the files of the job.
+    if (const ConfigOptionStrings* server_load = server_cli.input_config.option<ConfigOptionStrings>("load"); server_load != nullptr) {
+        std::vector<std::string> load = server_load->values;
+        if (const ConfigOptionStrings* job_load = cli.input_config.option<ConfigOptionStrings>("load"); job_load != nullptr)
+            append(load, job_load->values);
+        cli.input_config.set_key_value("load", new ConfigOptionStrings(std::move(load)));
+    }
+
+    PrinterTechnology   printer_technology = get_printer_technology(cli.overrides_config);
+    DynamicPrintConfig  print_config       = {};
+    std::vector<Model>  models;
+
+    if (!load_print_data(models, print_config, printer_technology, cli))
+        return false;
+
+    // A job in the documented format supplies just the input, the output and the configuration.
+    // Export G-code or an SLA archive according to the printer technology, otherwise the job would produce nothing.
+    if (cli.actions_config.empty())
+        cli.actions_config.set_key_value(printer_technology == ptSLA ? "export_sla" : "export_gcode", new ConfigOptionBool(true));
+
+    // The confirmation of post-processing scripts is read from stdin by the command line interface,
+    // which carries the jobs in the server mode.
+    if (const ConfigOptionStrings* post_process = print_config.option<ConfigOptionStrings>("post_process");
+        post_process != nullptr && !post_process->values.empty()) {
+        boost::nowide::cerr << "Post-processing scripts are not allowed in the server mode." << std::endl;
+        return false;
+    }
+
+    return process_transform(cli, print_config, models) && process_actions(cli, print_config, models);
+}
+
+#ifndef _WIN32
+// Process a job in a worker process forked from the server. The worker shares the profiles preloaded by the server
+// and all the memory allocated by the job is returned to the system when the worker exits.
+static pid_t start_job_process(const Data& server_cli, const ServerJob& job)
+{
+    boost::nowide::cout.flush();
+    boost::nowide::cerr.flush();
+    std::fflush(nullptr);
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        // The standard output of the server carries the results of the jobs, redirect the messages of the job to the standard error.
+        ::dup2(STDERR_FILENO, STDOUT_FILENO);
+        const bool success = run_job(server_cli, job);
+        boost::nowide::cout.flush();
+        boost::nowide::cerr.flush();
+        std::fflush(nullptr);
+        ::_exit(success ? 0 : 1);
+    }
+    return pid;
+}
+#endif // _WIN32
+
+int run_server(const Data& cli)
+{
+    // Load the installed profiles before the jobs are started, so that the jobs do not load them again.
+    if (!preload_preset_bundle())
+        BOOST_LOG_TRIVIAL(info) << "Server: Installed profiles were not loaded, the jobs may only use the profiles supplied by --load.";
+
+    const size_t max_jobs = cli.misc_config.has("server_jobs") ? size_t(std::max(1, cli.misc_config.opt_int("server_jobs"))) : 1;
+
+#ifndef _WIN32
+    // Worker processes of the jobs being processed with the IDs of their jobs.
+    std::map<pid_t, std::string> running;
+    auto wait_for_job = [&running]() {
+        int         status = 0;
+        const pid_t pid    = ::waitpid(-1, &status, 0);
+        if (pid == -1) {
+            if (errno != EINTR) {
+                // No more children to wait for.
+                for (const auto& [pid, id] : running)
+                    write_result(id, false, "Lost the worker process.");
+                running.clear();
+            }
+            return;
+        }
+        if (auto it = running.find(pid); it != running.end()) {
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+                write_result(it->second, true, {});
+            else if (WIFSIGNALED(status))
+                write_result(it->second, false, "The worker process was terminated by signal " + std::to_string(WTERMSIG(status)) + ".");
+            else
+                write_result(it->second, false, "The job failed, see the error output of the server.");
+            running.erase(it);
+        }
+    };
+#endif // _WIN32
+
+    std::string line;
+    while (std::getline(boost::nowide::cin, line)) {
+        boost::trim(line);
+        if (line.empty())
+            continue;
+        ServerJob   job;
+        std::string error;
+        if (!parse_server_job(line, job, error)) {
+            write_result(job.id, false, error);
+            continue;
+        }
+#ifdef _WIN32
+        // No fork() on Windows, jobs are processed one after the other by the server process.
+        (void)max_jobs;
+        write_result(job.id, run_job(cli, job), {});
+#else
+        while (running.size() >= max_jobs)
+            wait_for_job();
+        if (const pid_t pid = start_job_process(cli, job); pid > 0)
+            running.emplace(pid, job.id);
+        else
+            write_result(job.id, false, "Failed to start a worker process.");
+#endif // _WIN32
+    }
+
+#ifndef _WIN32
+    while (!running.empty())
+        wait_for_job();
+#endif // _WIN32
+
+    return 0;
+}
+
+} // namespace Slic3r::CLI
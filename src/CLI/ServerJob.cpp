@@ -0,0 +1,70 @@
+#include "ServerJob.hpp"
+
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "libslic3r/Config.hpp"
+
+namespace Slic3r::CLI {
+
+namespace pt = boost::property_tree;
+
+bool parse_server_job(const std::string& line, ServerJob& job, std::string& error)
+{
+    pt::ptree tree;
+    try {
+        std::istringstream is(line);
+        pt::read_json(is, tree);
+    }
+    catch (const pt::json_parser_error& ex) {
+        error = std::string("Invalid job: ") + ex.what();
+        return false;
+    }
+
+    job.id = tree.get<std::string>("id", "");
+
+    // "input" and "args" may be either a single string or an array of strings.
+    auto append_values = [](const pt::ptree& node, std::vector<std::string>& out) {
+        if (node.empty())
+            out.emplace_back(node.data());
+        else
+            for (const auto& [key, value] : node)
+                out.emplace_back(value.data());
+    };
+    if (auto config = tree.get_child_optional("config")) {
+        // The keys are the configuration option keys as stored in the ini files (for example "layer_height"),
+        // not the command line names. Vector values are serialized the same way as in the ini files.
+        for (const auto& [opt_key, value] : *config) {
+            if (!value.empty()) {
+                error = "Invalid job: The value of the configuration option \"" + opt_key + "\" is not a string or a number.";
+                return false;
+            }
+            try {
+                job.config.set_deserialize_strict(opt_key, value.data());
+            }
+            catch (const ConfigurationError& ex) {
+                error = std::string("Invalid job: ") + ex.what();
+                return false;
+            }
+        }
+    }
+    if (auto output = tree.get_optional<std::string>("output"))
+        job.args.emplace_back("--output=" + *output);
+    if (auto args = tree.get_child_optional("args"))
+        append_values(*args, job.args);
+    if (auto input = tree.get_child_optional("input")) {
+        // Input files are passed after "--", they are not parsed as options.
+        job.args.emplace_back("--");
+        append_values(*input, job.args);
+    }
+
+    if (job.args.empty()) {
+        error = "Invalid job: Neither \"args\" nor \"input\" was supplied.";
+        return false;
+    }
+    return true;
+}
+
+} // namespace Slic3r::CLI
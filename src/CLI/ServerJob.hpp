@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "libslic3r/PrintConfig.hpp"
+
+namespace Slic3r::CLI
+{
+    // A job of the batch slicing server, see the tooltip of the "server" action for the format.
+    struct ServerJob
+    {
+        std::string                 id;
+        // Command line arguments of the job, without the program name.
+        std::vector<std::string>    args;
+        // Values of the "config" object, applied over the overrides of the command line arguments.
+        DynamicPrintConfig          config;
+    };
+
+            // parse a job from a JSON line, returns false and fills in error if the job is invalid
+    bool    parse_server_job(const std::string& line, ServerJob& job, std::string& error);
+}
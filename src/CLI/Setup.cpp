@@ -68,7 +68,7 @@ static CLI_DynamicPrintConfig* get_config(Data& data, Type type)
     return nullptr;
 }
 
-static bool read(Data& data, int argc, const char* const argv[])
+bool read_args(Data& data, int argc, const char* const argv[])
 {
     // cache the CLI option => opt_key mapping
     opts_map opts = get_opts_map(data);
@@ -306,7 +306,7 @@ bool setup(Data& cli, int argc, char** argv)
     if (!setup_common())
         return false;
 
-    if (!read(cli, argc, argv)) {
+    if (!read_args(cli, argc, argv)) {
         // Separate error message reported by the CLI parser from the help.
         boost::nowide::cerr << std::endl;
         print_help();
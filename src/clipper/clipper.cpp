@@ -766,8 +766,8 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   if ((Closed && highI < 2) || (!Closed && highI < 1))
     return false;
 
-  // Allocate a new edge array.
-  Edges edges(highI + 1);
+  // Allocate a new edge array or recycle an edge array released by Clear().
+  Edges edges = AllocateEdges(highI + 1);
   // Fill in the edge array.
   bool result = AddPathInternal(pg, highI, PolyTyp, Closed, edges.data());
   if (result)
@@ -956,9 +956,29 @@ bool ClipperBase::AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, b
 }
 //------------------------------------------------------------------------------
 
+ClipperBase::Edges ClipperBase::AllocateEdges(size_t num_edges)
+{
+  if (m_edges_free.empty())
+    return Edges(num_edges);
+  Edges edges = std::move(m_edges_free.back());
+  m_edges_free.pop_back();
+  edges.assign(num_edges, TEdge());
+  return edges;
+}
+//------------------------------------------------------------------------------
+
 void ClipperBase::Clear()
 {
   m_MinimaList.clear();
+  // Keep the edge arrays for the next AddPath() / AddPaths(), but limit the retained memory.
+  size_t num_free_edges = 0;
+  for (const Edges &edges : m_edges_free)
+    num_free_edges += edges.capacity();
+  for (Edges &edges : m_edges)
+    if (num_free_edges + edges.capacity() <= m_MaxFreeEdges) {
+      num_free_edges += edges.capacity();
+      m_edges_free.emplace_back(std::move(edges));
+    }
   m_edges.clear();
 #ifndef CLIPPERLIB_INT32
   m_UseFullRange = false;
@@ -1042,6 +1062,7 @@ IntRect ClipperBase::GetBounds()
 Clipper::Clipper(int initOptions) : 
   ClipperBase(),
   m_OutPtsFree(nullptr),
+  m_OutPtsChunks(0),
   m_OutPtsChunkLast(m_OutPtsChunkSize),
   m_ActiveEdges(nullptr),
   m_SortedEdges(nullptr)
@@ -1173,20 +1194,24 @@ OutPt* Clipper::AllocateOutPt()
     pt = m_OutPtsFree;
     m_OutPtsFree = pt->Next;
   } else if (m_OutPtsChunkLast < m_OutPtsChunkSize) {
-    // Get a point from the last chunk.
-    pt = &m_OutPts.back()[m_OutPtsChunkLast ++];
+    // Get a point from the last chunk in use.
+    pt = &m_OutPts[m_OutPtsChunks - 1][m_OutPtsChunkLast ++];
   } else {
-    // The last chunk is full. Allocate a new one.
-    m_OutPts.emplace_back();
+    // The last chunk in use is full. Reuse a chunk kept by DisposeAllOutRecs() or allocate a new one.
+    if (m_OutPtsChunks == m_OutPts.size())
+      m_OutPts.emplace_back();
     m_OutPtsChunkLast = 1;
-    pt = &m_OutPts.back().front();
+    pt = &m_OutPts[m_OutPtsChunks ++].front();
   }
   return pt;
 }
 
 void Clipper::DisposeAllOutRecs()
 {
-  m_OutPts.clear();
+  // Keep some of the chunks of output points for the next Execute().
+  if (m_OutPts.size() > m_MaxFreeOutPtsChunks)
+    m_OutPts.resize(m_MaxFreeOutPtsChunks);
+  m_OutPtsChunks = 0;
   m_OutPtsFree = nullptr;
   m_OutPtsChunkLast = m_OutPtsChunkSize;
   m_PolyOuts.clear();
@@ -3465,7 +3490,9 @@ void ClipperOffset::Execute(Paths& solution, double delta)
   DoOffset(delta);
   
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3486,6 +3513,7 @@ void ClipperOffset::Execute(Paths& solution, double delta)
     if (! solution.empty())
       solution.erase(solution.begin());
   }
+  clpr.Clear();
 }
 //------------------------------------------------------------------------------
 
@@ -3496,7 +3524,9 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
   DoOffset(delta);
 
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3517,6 +3547,7 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
     //remove the outer PolyNode rectangle ...
     solution.RemoveOutermostPolygon();
   }
+  clpr.Clear();
 }
 //------------------------------------------------------------------------------
 
@@ -357,8 +357,8 @@ public:
     if (num_edges_total == 0)
       return false;
 
-    // Allocate a new edge array.
-    std::vector<TEdge, Allocator<TEdge>> edges(num_edges_total);
+    // Allocate a new edge array or recycle an edge array released by Clear().
+    Edges edges = AllocateEdges(num_edges_total);
     // Fill in the edge array.
     bool result = false;
     TEdge *p_edge = edges.data();
@@ -387,6 +387,8 @@ public:
   void PreserveCollinear(bool value) {m_PreserveCollinear = value;};
 protected:
   bool AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges);
+  // Allocate a zero initialized edge array, possibly recycling an edge array released by Clear().
+  std::vector<TEdge, Allocator<TEdge>> AllocateEdges(size_t num_edges);
   TEdge* AddBoundsToLML(TEdge *e, bool IsClosed);
   void Reset();
   TEdge* ProcessBound(TEdge* E, bool IsClockwise);
@@ -407,6 +409,11 @@ protected:
   // A vector of edges per each input path.
   using Edges = std::vector<TEdge, Allocator<TEdge>>;
   std::vector<Edges, Allocator<Edges>> m_edges;
+  // Edge arrays released by Clear() to be recycled by AddPath() / AddPaths(), so that a Clipper instance reused
+  // for many boolean operations does not allocate its edges again and again.
+  std::vector<Edges, Allocator<Edges>> m_edges_free;
+  // Limit of the number of edges kept in m_edges_free.
+  static constexpr const size_t m_MaxFreeEdges = 65536;
   // Don't remove intermediate vertices of a collinear sequence of points.
   bool             m_PreserveCollinear;
   // Is any of the paths inserted by AddPath() or AddPaths() open?
@@ -452,10 +459,15 @@ private:
   // Output polygons.
   std::deque<OutRec, Allocator<OutRec>>  m_PolyOuts;
   // Output points, allocated by a continuous sets of m_OutPtsChunkSize.
+  // The chunks are kept allocated by DisposeAllOutRecs() up to m_MaxFreeOutPtsChunks to be reused by the next Execute().
   static constexpr const size_t m_OutPtsChunkSize = 32;
+  static constexpr const size_t m_MaxFreeOutPtsChunks = 1024;
   std::deque<std::array<OutPt, m_OutPtsChunkSize>, Allocator<std::array<OutPt, m_OutPtsChunkSize>>> m_OutPts;
   // List of free output points, to be used before taking a point from m_OutPts or allocating a new chunk.
   OutPt                *m_OutPtsFree;
+  // Number of chunks of m_OutPts in use, the chunks past m_OutPtsChunks are free.
+  size_t                m_OutPtsChunks;
+  // Number of points used from the last chunk in use.
   size_t                m_OutPtsChunkLast;
 
   std::vector<Join, Allocator<Join>>     m_Joins;
@@ -538,7 +550,10 @@ private:
 class ClipperOffset 
 {
 public:
-  ClipperOffset(double miterLimit = 2.0, double roundPrecision = 0.25, double shortestEdgeLength = 0.) :
+  static constexpr const double DefaultMiterLimit         = 2.0;
+  static constexpr const double DefaultArcTolerance       = 0.25;
+  static constexpr const double DefaultShortestEdgeLength = 0.;
+  ClipperOffset(double miterLimit = DefaultMiterLimit, double roundPrecision = DefaultArcTolerance, double shortestEdgeLength = DefaultShortestEdgeLength) :
     MiterLimit(miterLimit), ArcTolerance(roundPrecision), ShortestEdgeLength(shortestEdgeLength), m_lowest(-1, 0) {}
   ~ClipperOffset() { Clear(); }
   void AddPath(const Path& path, JoinType joinType, EndType endType);
@@ -555,6 +570,8 @@ public:
   double ShortestEdgeLength;
 
 private:
+  // Clipper cleaning up the offsetted paths, kept to recycle its memory when the ClipperOffset is reused.
+  Clipper m_clipper;
   Paths m_destPolys;
   Path m_srcPoly;
   Path m_destPoly;
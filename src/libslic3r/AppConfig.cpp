@@ -132,6 +132,10 @@ void AppConfig::set_defaults()
 
         if (get("use_binary_gcode_when_supported").empty())
             set("use_binary_gcode_when_supported", "1");
+
+        // The persistent cache of tree support volumes may take up to 1GB of disk space, it is disabled by default.
+        if (get("tree_support_disk_cache").empty())
+            set("tree_support_disk_cache", "0");
  
        if (get("notify_release").empty())
            set("notify_release", "all"); // or "none" or "release"
@@ -4,9 +4,14 @@
 #include "BeadingStrategyFactory.hpp"
 
 #include <boost/log/trivial.hpp>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <tuple>
 #include <utility>
 
+#include "CachedBeadingStrategy.hpp"
 #include "LimitedBeadingStrategy.hpp"
 #include "WideningBeadingStrategy.hpp"
 #include "DistributedBeadingStrategy.hpp"
@@ -55,4 +60,92 @@ BeadingStrategyPtr BeadingStrategyFactory::makeStrategy(const coord_t preferred_
     ret = std::make_unique<LimitedBeadingStrategy>(max_bead_count, std::move(ret));
     return ret;
 }
+
+namespace {
+
+using CachedStrategyKey = std::tuple<coord_t, coord_t, coord_t, float, bool, coord_t, coord_t, double, double, coord_t, coord_t, int, double>;
+
+// Strategy chains shared while at least one BeadingStrategyFactory::CacheScope is alive.
+struct CachedStrategies
+{
+    struct Entry {
+        std::shared_ptr<const BeadingStrategy> strategy;
+        size_t                                 timestamp;
+    };
+    // The number of different parameter sets is small (per region and per layer height),
+    // the least recently used chains are released when the limit is reached. Chains in use are kept alive by their users.
+    static constexpr size_t              max_strategies = 32;
+    std::mutex                           mutex;
+    std::map<CachedStrategyKey, Entry>   strategies;
+    size_t                               timestamp  = 0;
+    size_t                               num_scopes = 0;
+};
+
+CachedStrategies& cached_strategies()
+{
+    static CachedStrategies instance;
+    return instance;
+}
+
+} // namespace
+
+BeadingStrategyFactory::CacheScope::CacheScope()
+{
+    CachedStrategies &cache = cached_strategies();
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    ++ cache.num_scopes;
+}
+
+BeadingStrategyFactory::CacheScope::~CacheScope()
+{
+    CachedStrategies &cache = cached_strategies();
+    std::map<CachedStrategyKey, CachedStrategies::Entry> released;
+    {
+        std::scoped_lock<std::mutex> lock(cache.mutex);
+        if (-- cache.num_scopes == 0)
+            // Release the memoized beadings outside of the lock.
+            released.swap(cache.strategies);
+    }
+}
+
+std::shared_ptr<const BeadingStrategy> BeadingStrategyFactory::makeCachedStrategy(const coord_t preferred_bead_width_outer,
+                                                                                  const coord_t preferred_bead_width_inner,
+                                                                                  const coord_t preferred_transition_length,
+                                                                                  const float   transitioning_angle,
+                                                                                  const bool    print_thin_walls,
+                                                                                  const coord_t min_bead_width,
+                                                                                  const coord_t min_feature_size,
+                                                                                  const double  wall_split_middle_threshold,
+                                                                                  const double  wall_add_middle_threshold,
+                                                                                  const coord_t max_bead_count,
+                                                                                  const coord_t outer_wall_offset,
+                                                                                  const int     inward_distributed_center_wall_count,
+                                                                                  const double  minimum_variable_line_ratio)
+{
+    auto make_strategy = [&]() {
+        return makeStrategy(preferred_bead_width_outer, preferred_bead_width_inner, preferred_transition_length, transitioning_angle, print_thin_walls,
+            min_bead_width, min_feature_size, wall_split_middle_threshold, wall_add_middle_threshold, max_bead_count, outer_wall_offset,
+            inward_distributed_center_wall_count, minimum_variable_line_ratio);
+    };
+    const CachedStrategyKey key { preferred_bead_width_outer, preferred_bead_width_inner, preferred_transition_length, transitioning_angle, print_thin_walls,
+                                  min_bead_width, min_feature_size, wall_split_middle_threshold, wall_add_middle_threshold, max_bead_count, outer_wall_offset,
+                                  inward_distributed_center_wall_count, minimum_variable_line_ratio };
+
+    CachedStrategies &cache = cached_strategies();
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    if (cache.num_scopes == 0)
+        // Nobody would release the memoized beadings, don't share the strategy.
+        return std::shared_ptr<const BeadingStrategy>(make_strategy());
+    if (auto it = cache.strategies.find(key); it != cache.strategies.end()) {
+        it->second.timestamp = ++ cache.timestamp;
+        return it->second.strategy;
+    }
+    if (cache.strategies.size() >= CachedStrategies::max_strategies)
+        cache.strategies.erase(std::min_element(cache.strategies.begin(), cache.strategies.end(),
+            [](const auto &l, const auto &r) { return l.second.timestamp < r.second.timestamp; }));
+    auto strategy = std::make_shared<const CachedBeadingStrategy>(make_strategy());
+    cache.strategies.emplace(key, CachedStrategies::Entry{ strategy, ++ cache.timestamp });
+    return strategy;
+}
+
 } // namespace Slic3r::Arachne
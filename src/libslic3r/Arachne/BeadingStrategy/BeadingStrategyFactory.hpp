@@ -6,6 +6,7 @@
 
 #include <math.h>
 #include <cmath>
+#include <memory>
 
 #include "BeadingStrategy.hpp"
 #include "../../Point.hpp"
@@ -33,6 +34,43 @@ public:
         int inward_distributed_center_wall_count = 2,
         double minimum_variable_line_width = 0.5
     );
+
+    /*!
+     * Keeps the strategy chains returned by makeCachedStrategy() shared while alive, typically for a single
+     * PrintObject::make_perimeters() run. The chains and their memoized beadings are released
+     * when the last scope ends.
+     */
+    class CacheScope
+    {
+    public:
+        CacheScope();
+        ~CacheScope();
+        CacheScope(const CacheScope &) = delete;
+        CacheScope& operator=(const CacheScope &) = delete;
+    };
+
+    /*!
+     * Same as makeStrategy(), but the returned strategy chain memoizes its beadings (see CachedBeadingStrategy)
+     * and it is shared with the other callers requesting a strategy with the same parameters, typically
+     * the other layers of the same object sliced in parallel. The chain is only shared and memoizing
+     * while a CacheScope is alive, otherwise the plain makeStrategy() chain is returned.
+     */
+    static std::shared_ptr<const BeadingStrategy> makeCachedStrategy
+    (
+        coord_t preferred_bead_width_outer,
+        coord_t preferred_bead_width_inner,
+        coord_t preferred_transition_length,
+        float transitioning_angle,
+        bool print_thin_walls,
+        coord_t min_bead_width,
+        coord_t min_feature_size,
+        double wall_split_middle_threshold,
+        double wall_add_middle_threshold,
+        coord_t max_bead_count,
+        coord_t outer_wall_offset,
+        int inward_distributed_center_wall_count,
+        double minimum_variable_line_width = 0.5
+    );
 };
 
 } // namespace Slic3r::Arachne
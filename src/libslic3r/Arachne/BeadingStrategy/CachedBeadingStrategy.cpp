@@ -0,0 +1,109 @@
+#include "CachedBeadingStrategy.hpp"
+
+#include <mutex>
+#include <utility>
+
+namespace Slic3r::Arachne
+{
+
+CachedBeadingStrategy::CachedBeadingStrategy(BeadingStrategyPtr parent)
+    : BeadingStrategy(*parent)
+    , parent(std::move(parent))
+{}
+
+std::string CachedBeadingStrategy::toString() const
+{
+    return std::string("CachedBeadingStrategy+") + parent->toString();
+}
+
+static inline uint64_t thickness_key(coord_t thickness)
+{
+    // Don't sign extend negative thicknesses.
+    return uint64_t(uint32_t(thickness));
+}
+
+static inline uint64_t beading_key(coord_t thickness, coord_t bead_count)
+{
+    // Thickness and bead count of a beading both fit into 32 bits.
+    return (thickness_key(thickness) << 32) | uint64_t(uint32_t(bead_count));
+}
+
+static inline size_t shard_idx(uint64_t key, size_t num_shards)
+{
+    return ankerl::unordered_dense::detail::wyhash::hash(key) % num_shards;
+}
+
+CachedBeadingStrategy::Beading CachedBeadingStrategy::compute(coord_t thickness, coord_t bead_count) const
+{
+    const uint64_t key   = beading_key(thickness, bead_count);
+    Shard         &shard = m_shards[shard_idx(key, NUM_SHARDS)];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        if (auto it = shard.beadings.find(key); it != shard.beadings.end())
+            return it->second;
+    }
+    Beading beading = parent->compute(thickness, bead_count);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.beadings.size() >= MAX_SHARD_SIZE)
+            shard.beadings.clear();
+        shard.beadings.emplace(key, beading);
+    }
+    return beading;
+}
+
+coord_t CachedBeadingStrategy::getOptimalBeadCount(coord_t thickness) const
+{
+    const uint64_t key   = thickness_key(thickness);
+    Shard         &shard = m_shards[shard_idx(key, NUM_SHARDS)];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        if (auto it = shard.bead_counts.find(key); it != shard.bead_counts.end())
+            return it->second;
+    }
+    const coord_t bead_count = parent->getOptimalBeadCount(thickness);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.bead_counts.size() >= MAX_SHARD_SIZE)
+            shard.bead_counts.clear();
+        shard.bead_counts.emplace(key, bead_count);
+    }
+    return bead_count;
+}
+
+coord_t CachedBeadingStrategy::getOptimalThickness(coord_t bead_count) const
+{
+    return parent->getOptimalThickness(bead_count);
+}
+
+coord_t CachedBeadingStrategy::getTransitionThickness(coord_t lower_bead_count) const
+{
+    return parent->getTransitionThickness(lower_bead_count);
+}
+
+coord_t CachedBeadingStrategy::getTransitioningLength(coord_t lower_bead_count) const
+{
+    return parent->getTransitioningLength(lower_bead_count);
+}
+
+float CachedBeadingStrategy::getTransitionAnchorPos(coord_t lower_bead_count) const
+{
+    return parent->getTransitionAnchorPos(lower_bead_count);
+}
+
+std::vector<coord_t> CachedBeadingStrategy::getNonlinearThicknesses(coord_t lower_bead_count) const
+{
+    return parent->getNonlinearThicknesses(lower_bead_count);
+}
+
+size_t CachedBeadingStrategy::num_cached_beadings() const
+{
+    size_t num = 0;
+    for (const Shard &shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        num += shard.beadings.size();
+    }
+    return num;
+}
+
+} // namespace Slic3r::Arachne
@@ -0,0 +1,68 @@
+#ifndef slic3r_CachedBeadingStrategy_hpp_
+#define slic3r_CachedBeadingStrategy_hpp_
+
+#include <ankerl/unordered_dense.h>
+#include <array>
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "BeadingStrategy.hpp"
+#include "libslic3r/libslic3r.h"
+
+namespace Slic3r::Arachne
+{
+
+/*!
+ * This is a meta-strategy that memoizes compute() and getOptimalBeadCount() of the wrapped strategy chain.
+ *
+ * SkeletalTrapezoidation evaluates the beading for every node of the skeleton and the same thicknesses
+ * repeat a lot, both inside a layer (all the nodes on the outline have zero thickness) and between layers
+ * of prismatic parts. The results are cached by the exact thickness: the thickness is already quantized
+ * to the scaled coordinates and a coarser quantization would break the requirement of compute() that
+ * the bead widths change gradually with the thickness.
+ *
+ * The cache is thread safe, thus a single instance may be shared by all the threads slicing layers with
+ * the same beading parameters, see BeadingStrategyFactory::makeCachedStrategy().
+ */
+class CachedBeadingStrategy : public BeadingStrategy
+{
+public:
+    explicit CachedBeadingStrategy(BeadingStrategyPtr parent);
+
+    ~CachedBeadingStrategy() override = default;
+
+    Beading compute(coord_t thickness, coord_t bead_count) const override;
+    coord_t getOptimalThickness(coord_t bead_count) const override;
+    coord_t getTransitionThickness(coord_t lower_bead_count) const override;
+    coord_t getOptimalBeadCount(coord_t thickness) const override;
+    coord_t getTransitioningLength(coord_t lower_bead_count) const override;
+    float getTransitionAnchorPos(coord_t lower_bead_count) const override;
+    std::vector<coord_t> getNonlinearThicknesses(coord_t lower_bead_count) const override;
+    std::string toString() const override;
+
+    // Number of cached beadings, for statistics and tests.
+    size_t num_cached_beadings() const;
+
+protected:
+    const BeadingStrategyPtr parent;
+
+private:
+    // The cache is split into shards guarded by separate mutexes to limit contention between threads.
+    static constexpr size_t NUM_SHARDS = 64;
+    // Limit of cached values per shard. A full shard is emptied before a new value is cached, thus one-off
+    // thicknesses do not block caching of the thicknesses that repeat.
+    static constexpr size_t MAX_SHARD_SIZE = 1024;
+
+    struct Shard
+    {
+        mutable std::shared_mutex                                   mutex;
+        ankerl::unordered_dense::map<uint64_t, Beading>             beadings;
+        ankerl::unordered_dense::map<uint64_t, coord_t>             bead_counts;
+    };
+    mutable std::array<Shard, NUM_SHARDS> m_shards;
+};
+
+} // namespace Slic3r::Arachne
+#endif // slic3r_CachedBeadingStrategy_hpp_
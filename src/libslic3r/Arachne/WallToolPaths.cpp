@@ -8,6 +8,8 @@
 #include <cinttypes>
 #include <cmath>
 
+#include <tbb/parallel_for.h>
+
 #include "WallToolPaths.hpp"
 #include "SkeletalTrapezoidation.hpp"
 #include "utils/linearAlg2D.hpp"
@@ -482,9 +484,10 @@ const std::vector<VariableWidthLines> &WallToolPaths::generate()
     // Applying Clipper union should be enough to get rid of this issue.
     // Clipper union also fixed an issue in Arachne that in post-processing Voronoi diagram, some edges
     // didn't have twin edges. (a non-planar Voronoi diagram probably caused this).
-    prepared_outline = union_(prepared_outline);
+    // The islands of the outline are processed independently, see below.
+    const ExPolygons prepared_islands = union_ex(prepared_outline);
 
-    if (area(prepared_outline) <= 0) {
+    if (area(prepared_islands) <= 0) {
         assert(toolpaths.empty());
         return toolpaths;
     }
@@ -497,7 +500,7 @@ const std::vector<VariableWidthLines> &WallToolPaths::generate()
 
     const int wall_distribution_count = this->print_object_config.wall_distribution_count.value;
     const size_t max_bead_count = (inset_count < std::numeric_limits<coord_t>::max() / 2) ? 2 * inset_count : std::numeric_limits<coord_t>::max();
-    const auto beading_strat = BeadingStrategyFactory::makeStrategy
+    const auto beading_strat = BeadingStrategyFactory::makeCachedStrategy
         (
             bead_width_0,
             bead_width_x,
@@ -514,17 +517,35 @@ const std::vector<VariableWidthLines> &WallToolPaths::generate()
         );
     const coord_t transition_filter_dist   = scaled<coord_t>(100.f);
     const coord_t allowed_filter_deviation = wall_transition_filter_deviation;
-    SkeletalTrapezoidation wall_maker
-    (
-        prepared_outline,
-        *beading_strat,
-        beading_strat->getTransitioningAngle(),
-        discretization_step_size,
-        transition_filter_dist,
-        allowed_filter_deviation,
-        wall_transition_length
-    );
-    wall_maker.generateToolpaths(toolpaths);
+
+    // The medial axis inside an island does not depend on the other islands, because the boundary of an island
+    // is always closer to its interior than any other island. Thus the Voronoi diagram, the skeletal trapezoidation
+    // and the beading are calculated for each island separately and in parallel, which makes layers with many islands
+    // scale with the number of cores. The toolpaths of the islands are merged in the order of the islands,
+    // thus the result does not depend on the scheduling.
+    std::vector<std::vector<VariableWidthLines>> island_toolpaths(prepared_islands.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, prepared_islands.size(), 1), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t island_idx = range.begin(); island_idx < range.end(); ++ island_idx) {
+            SkeletalTrapezoidation wall_maker
+            (
+                to_polygons(prepared_islands[island_idx]),
+                *beading_strat,
+                beading_strat->getTransitioningAngle(),
+                discretization_step_size,
+                transition_filter_dist,
+                allowed_filter_deviation,
+                wall_transition_length
+            );
+            wall_maker.generateToolpaths(island_toolpaths[island_idx]);
+        }
+    });
+
+    for (std::vector<VariableWidthLines> &island : island_toolpaths) {
+        if (toolpaths.size() < island.size())
+            toolpaths.resize(island.size());
+        for (size_t inset_idx = 0; inset_idx < island.size(); ++ inset_idx)
+            append(toolpaths[inset_idx], std::move(island[inset_idx]));
+    }
 
     stitchToolPaths(toolpaths, this->bead_width_x);
 
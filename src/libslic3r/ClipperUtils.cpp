@@ -21,6 +21,7 @@
 #include "libslic3r/libslic3r.h"
 
 #include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/parallel_reduce.h>
 
 // #define CLIPPER_UTILS_TIMING
@@ -206,6 +207,60 @@ namespace ClipperUtils {
         out.erase(std::remove_if(out.begin(), out.end(), [](const Polygon &polygon) {return polygon.empty(); }), out.end());
         return out;
     }
+
+    template<typename Engine>
+    struct ThreadEngine {
+        Engine  engine;
+        bool    borrowed { false };
+    };
+
+    template<typename Engine>
+    static ThreadEngine<Engine>& thread_engine()
+    {
+        thread_local ThreadEngine<Engine> thread_engine;
+        return thread_engine;
+    }
+
+    // Restore the parameters of a reused engine to the defaults of a newly constructed engine.
+    static void reset_engine_parameters(ClipperLib::Clipper &clipper)
+    {
+        clipper.ReverseSolution(false);
+        clipper.StrictlySimple(false);
+        clipper.PreserveCollinear(false);
+    }
+    static void reset_engine_parameters(ClipperLib::ClipperOffset &co)
+    {
+        // Don't construct a defaults object, the Clipper embedded in ClipperOffset allocates when constructed.
+        co.MiterLimit         = ClipperLib::ClipperOffset::DefaultMiterLimit;
+        co.ArcTolerance       = ClipperLib::ClipperOffset::DefaultArcTolerance;
+        co.ShortestEdgeLength = ClipperLib::ClipperOffset::DefaultShortestEdgeLength;
+    }
+
+    template<typename Engine>
+    EngineScope<Engine>::EngineScope()
+    {
+        ThreadEngine<Engine> &cached = thread_engine<Engine>();
+        if (cached.borrowed) {
+            m_temp   = std::make_unique<Engine>();
+            m_engine = m_temp.get();
+        } else {
+            cached.borrowed = true;
+            m_engine        = &cached.engine;
+            reset_engine_parameters(*m_engine);
+        }
+    }
+
+    template<typename Engine>
+    EngineScope<Engine>::~EngineScope()
+    {
+        if (! m_temp) {
+            m_engine->Clear();
+            thread_engine<Engine>().borrowed = false;
+        }
+    }
+
+    template class EngineScope<ClipperLib::Clipper>;
+    template class EngineScope<ClipperLib::ClipperOffset>;
 }
 
 static ExPolygons PolyTreeToExPolygons(ClipperLib::PolyTree &&polytree)
@@ -310,23 +365,23 @@ static ClipperLib::Paths raw_offset(PathsProvider &&paths, float offset, Clipper
 {
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
-    ClipperLib::ClipperOffset co;
+    ClipperUtils::ClipperOffsetScope co;
     ClipperLib::Paths out;
     out.reserve(paths.size());
     ClipperLib::Paths out_this;
     if (joinType == jtRound)
-        co.ArcTolerance = miterLimit;
+        co->ArcTolerance = miterLimit;
     else
-        co.MiterLimit = miterLimit;
-    co.ShortestEdgeLength = std::abs(offset * ClipperOffsetShortestEdgeFactor);
+        co->MiterLimit = miterLimit;
+    co->ShortestEdgeLength = std::abs(offset * ClipperOffsetShortestEdgeFactor);
     for (const ClipperLib::Path &path : paths) {
-        co.Clear();
+        co->Clear();
         // Execute reorients the contours so that the outer most contour has a positive area. Thus the output
         // contours will be CCW oriented even though the input paths are CW oriented.
         // Offset is applied after contour reorientation, thus the signum of the offset value is reversed.
-        co.AddPath(path, joinType, endType);
+        co->AddPath(path, joinType, endType);
         bool ccw = endType == ClipperLib::etClosedPolygon ? ClipperLib::Orientation(path) : true;
-        co.Execute(out_this, ccw ? offset : - offset);
+        co->Execute(out_this, ccw ? offset : - offset);
         if (! ccw) {
             // Reverse the resulting contours.
             for (ClipperLib::Path &path : out_this)
@@ -353,11 +408,11 @@ TResult clipper_do(
 {
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
-    clipper.AddPaths(std::forward<TClip>(clip),    ClipperLib::ptClip,    true);
+    ClipperUtils::ClipperScope clipper;
+    clipper->AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
+    clipper->AddPaths(std::forward<TClip>(clip),    ClipperLib::ptClip,    true);
     TResult retval;
-    clipper.Execute(clipType, retval, fillType, fillType);
+    clipper->Execute(clipType, retval, fillType, fillType);
     return retval;
 }
 
@@ -384,10 +439,10 @@ TResult clipper_union(
 {
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
+    ClipperUtils::ClipperScope clipper;
+    clipper->AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
     TResult retval;
-    clipper.Execute(ClipperLib::ctUnion, retval, fillType, fillType);
+    clipper->Execute(ClipperLib::ctUnion, retval, fillType, fillType);
     return retval;
 }
 
@@ -427,12 +482,12 @@ static TResult shrink_paths(PathsProvider &&paths, float offset, ClipperLib::Joi
     assert(offset > 0);
     TResult out;
     if (auto raw = raw_offset(std::forward<PathsProvider>(paths), - offset, joinType, miterLimit); ! raw.empty()) {
-        ClipperLib::Clipper clipper;
-        clipper.AddPaths(raw, ClipperLib::ptSubject, true);
-        ClipperLib::IntRect r = clipper.GetBounds();
-        clipper.AddPath({ { r.left - 10, r.bottom + 10 }, { r.right + 10, r.bottom + 10 }, { r.right + 10, r.top - 10 }, { r.left - 10, r.top - 10 } }, ClipperLib::ptSubject, true);
-        clipper.ReverseSolution(true);
-        clipper.Execute(ClipperLib::ctUnion, out, ClipperLib::pftNegative, ClipperLib::pftNegative);
+        ClipperUtils::ClipperScope clipper;
+        clipper->AddPaths(raw, ClipperLib::ptSubject, true);
+        ClipperLib::IntRect r = clipper->GetBounds();
+        clipper->AddPath({ { r.left - 10, r.bottom + 10 }, { r.right + 10, r.bottom + 10 }, { r.right + 10, r.top - 10 }, { r.left - 10, r.top - 10 } }, ClipperLib::ptSubject, true);
+        clipper->ReverseSolution(true);
+        clipper->Execute(ClipperLib::ctUnion, out, ClipperLib::pftNegative, ClipperLib::pftNegative);
         remove_outermost_polygon(out);
     }
     return out;
@@ -475,14 +530,14 @@ static int offset_expolygon_inner(const Slic3r::ExPolygon &expoly, const float d
     // 1) Offset the outer contour.
     ClipperLib::Paths contours;
     {
-        ClipperLib::ClipperOffset co;
+        ClipperUtils::ClipperOffsetScope co;
         if (joinType == jtRound)
-            co.ArcTolerance = miterLimit;
+            co->ArcTolerance = miterLimit;
         else
-            co.MiterLimit = miterLimit;
-        co.ShortestEdgeLength = std::abs(delta * ClipperOffsetShortestEdgeFactor);
-        co.AddPath(expoly.contour.points, joinType, ClipperLib::etClosedPolygon);
-        co.Execute(contours, delta);
+            co->MiterLimit = miterLimit;
+        co->ShortestEdgeLength = std::abs(delta * ClipperOffsetShortestEdgeFactor);
+        co->AddPath(expoly.contour.points, joinType, ClipperLib::etClosedPolygon);
+        co->Execute(contours, delta);
     }
     if (contours.empty())
         // No need to try to offset the holes.
@@ -496,18 +551,18 @@ static int offset_expolygon_inner(const Slic3r::ExPolygon &expoly, const float d
         ClipperLib::Paths holes;
         {
             for (const Polygon &hole : expoly.holes) {
-                ClipperLib::ClipperOffset co;
+                ClipperUtils::ClipperOffsetScope co;
                 if (joinType == jtRound)
-                    co.ArcTolerance = miterLimit;
+                    co->ArcTolerance = miterLimit;
                 else
-                    co.MiterLimit = miterLimit;
-                co.ShortestEdgeLength = std::abs(delta * ClipperOffsetShortestEdgeFactor);
-                co.AddPath(hole.points, joinType, ClipperLib::etClosedPolygon);
+                    co->MiterLimit = miterLimit;
+                co->ShortestEdgeLength = std::abs(delta * ClipperOffsetShortestEdgeFactor);
+                co->AddPath(hole.points, joinType, ClipperLib::etClosedPolygon);
                 ClipperLib::Paths out2;
                 // Execute reorients the contours so that the outer most contour has a positive area. Thus the output
                 // contours will be CCW oriented even though the input paths are CW oriented.
                 // Offset is applied after contour reorientation, thus the signum of the offset value is reversed.
-                co.Execute(out2, - delta);
+                co->Execute(out2, - delta);
                 append(holes, std::move(out2));
             }
         }
@@ -840,16 +895,75 @@ Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPol
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper_ex(ClipperLib::ctXor, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
 
+static inline ClipperUtils::PolygonsProvider   clipper_batch_provider(const Polygons *polygons)     { return ClipperUtils::PolygonsProvider(*polygons); }
+static inline ClipperUtils::ExPolygonProvider  clipper_batch_provider(const ExPolygon *expolygon)   { return ClipperUtils::ExPolygonProvider(*expolygon); }
+static inline ClipperUtils::ExPolygonsProvider clipper_batch_provider(const ExPolygons *expolygons) { return ClipperUtils::ExPolygonsProvider(*expolygons); }
+
+// Call fn(idx) for all operations of a batch. Operations on small inputs are cheap, thus they are processed in chunks.
+template<typename Fn>
+static void clipper_batch_for_each(size_t num_operations, bool parallel, Fn &&fn)
+{
+    if (parallel && num_operations > 1)
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_operations, 8), [&fn](const tbb::blocked_range<size_t> &range) {
+            for (size_t idx = range.begin(); idx < range.end(); ++ idx)
+                fn(idx);
+        });
+    else
+        for (size_t idx = 0; idx < num_operations; ++ idx)
+            fn(idx);
+}
+
+// Intersection of inputs with disjoint bounding boxes is empty, no need to call Clipper.
+template<typename TInput>
+static bool clipper_batch_empty_intersection(ClipperLib::ClipType type, const TInput &subject, const TInput &clip, ApplySafetyOffset do_safety_offset)
+{
+    if (type != ClipperLib::ctIntersection)
+        return false;
+    BoundingBox bbox_subject = std::visit([](auto input) { return get_extents(*input); }, subject);
+    BoundingBox bbox_clip    = std::visit([](auto input) { return get_extents(*input); }, clip);
+    if (! bbox_subject.defined || ! bbox_clip.defined)
+        return true;
+    if (do_safety_offset == ApplySafetyOffset::Yes)
+        bbox_clip.offset(ClipperSafetyOffset);
+    return ! bbox_subject.overlap(bbox_clip);
+}
+
+std::vector<Polygons> ClipperBatch::execute(bool parallel) const
+{
+    std::vector<Polygons> out(m_operations.size());
+    clipper_batch_for_each(m_operations.size(), parallel, [this, &out](size_t idx) {
+        const Operation &op = m_operations[idx];
+        if (! clipper_batch_empty_intersection(op.type, op.subject, op.clip, op.do_safety_offset))
+            out[idx] = std::visit([&op](auto subject, auto clip) {
+                return _clipper(op.type, clipper_batch_provider(subject), clipper_batch_provider(clip), op.do_safety_offset);
+            }, op.subject, op.clip);
+    });
+    return out;
+}
+
+std::vector<ExPolygons> ClipperBatch::execute_ex(bool parallel) const
+{
+    std::vector<ExPolygons> out(m_operations.size());
+    clipper_batch_for_each(m_operations.size(), parallel, [this, &out](size_t idx) {
+        const Operation &op = m_operations[idx];
+        if (! clipper_batch_empty_intersection(op.type, op.subject, op.clip, op.do_safety_offset))
+            out[idx] = std::visit([&op](auto subject, auto clip) {
+                return _clipper_ex(op.type, clipper_batch_provider(subject), clipper_batch_provider(clip), op.do_safety_offset);
+            }, op.subject, op.clip);
+    });
+    return out;
+}
+
 template<typename PathsProvider1, typename PathsProvider2>
 Polylines _clipper_pl_open(ClipperLib::ClipType clipType, PathsProvider1 &&subject, PathsProvider2 &&clip)
 {
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<PathsProvider1>(subject), ClipperLib::ptSubject, false);
-    clipper.AddPaths(std::forward<PathsProvider2>(clip), ClipperLib::ptClip, true);
+    ClipperUtils::ClipperScope clipper;
+    clipper->AddPaths(std::forward<PathsProvider1>(subject), ClipperLib::ptSubject, false);
+    clipper->AddPaths(std::forward<PathsProvider2>(clip), ClipperLib::ptClip, true);
     ClipperLib::PolyTree retval;
-    clipper.Execute(clipType, retval, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    clipper->Execute(clipType, retval, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     return PolyTreeToPolylines(std::move(retval));
 }
 
@@ -1047,12 +1161,12 @@ Polygons simplify_polygons(const Polygons &subject) {
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
     ClipperLib::Paths output;
-    ClipperLib::Clipper c;
-//    c.PreserveCollinear(true);
+    ClipperUtils::ClipperScope c;
+//    c->PreserveCollinear(true);
     //FIXME StrictlySimple is very expensive! Is it needed?
-    c.StrictlySimple(true);
-    c.AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    c->StrictlySimple(true);
+    c->AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
+    c->Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     return to_polygons(std::move(output));
 }
 
@@ -1061,12 +1175,12 @@ Polygons top_level_islands(const Slic3r::Polygons &polygons)
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ClipperUtils::ClipperScope clipper;
+    clipper->Clear();
     // perform union
-    clipper.AddPaths(ClipperUtils::PolygonsProvider(polygons), ClipperLib::ptSubject, true);
+    clipper->AddPaths(ClipperUtils::PolygonsProvider(polygons), ClipperLib::ptSubject, true);
     ClipperLib::PolyTree polytree;
-    clipper.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
+    clipper->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
     // Convert only the top level islands to the output.
     Polygons out;
     out.reserve(polytree.ChildCount());
@@ -1087,10 +1201,10 @@ ClipperLib::Paths fix_after_outer_offset(
 
   	ClipperLib::Paths solution;
   	if (! input.empty()) {
-		ClipperLib::Clipper clipper;
-	  	clipper.AddPath(input, ClipperLib::ptSubject, true);
-		clipper.ReverseSolution(reverse_result);
-		clipper.Execute(ClipperLib::ctUnion, solution, filltype, filltype);
+		ClipperUtils::ClipperScope clipper;
+	  	clipper->AddPath(input, ClipperLib::ptSubject, true);
+		clipper->ReverseSolution(reverse_result);
+		clipper->Execute(ClipperLib::ctUnion, solution, filltype, filltype);
 	}
     return solution;
 }
@@ -1107,16 +1221,16 @@ ClipperLib::Paths fix_after_inner_offset(
 
   	ClipperLib::Paths solution;
   	if (! input.empty()) {
-		ClipperLib::Clipper clipper;
-		clipper.AddPath(input, ClipperLib::ptSubject, true);
-		ClipperLib::IntRect r = clipper.GetBounds();
+		ClipperUtils::ClipperScope clipper;
+		clipper->AddPath(input, ClipperLib::ptSubject, true);
+		ClipperLib::IntRect r = clipper->GetBounds();
 		r.left -= 10; r.top -= 10; r.right += 10; r.bottom += 10;
 		if (filltype == ClipperLib::pftPositive)
-			clipper.AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.left, r.top), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.right, r.bottom) }, ClipperLib::ptSubject, true);
+			clipper->AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.left, r.top), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.right, r.bottom) }, ClipperLib::ptSubject, true);
 		else
-			clipper.AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.right, r.bottom), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.left, r.top) }, ClipperLib::ptSubject, true);
-		clipper.ReverseSolution(reverse_result);
-		clipper.Execute(ClipperLib::ctUnion, solution, filltype, filltype);
+			clipper->AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.right, r.bottom), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.left, r.top) }, ClipperLib::ptSubject, true);
+		clipper->ReverseSolution(reverse_result);
+		clipper->Execute(ClipperLib::ctUnion, solution, filltype, filltype);
 		if (! solution.empty())
 			solution.erase(solution.begin());
 	}
@@ -1306,13 +1420,13 @@ Polygons variable_offset_inner(const ExPolygon &expoly, const std::vector<std::v
 	if (holes.empty())
 		output = std::move(contours);
 	else {
-		ClipperLib::Clipper clipper;
-		clipper.Clear();
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
+		ClipperUtils::ClipperScope clipper;
+		clipper->Clear();
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
         // Holes may contain holes in holes produced by expanding a C hole shape.
         // The situation is processed correctly by Clipper diff operation.
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
-		clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
+		clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	}
 
 	return to_polygons(std::move(output));
@@ -1333,13 +1447,13 @@ ExPolygons variable_offset_inner_ex(const ExPolygon &expoly, const std::vector<s
         for (ClipperLib::Path &path : contours) 
             output.emplace_back(std::move(path));
     } else {
-        ClipperLib::Clipper clipper;
-        clipper.AddPaths(contours, ClipperLib::ptSubject, true);
+        ClipperUtils::ClipperScope clipper;
+        clipper->AddPaths(contours, ClipperLib::ptSubject, true);
         // Holes may contain holes in holes produced by expanding a C hole shape.
         // The situation is processed correctly by Clipper diff operation, producing concentric expolygons.
-        clipper.AddPaths(holes, ClipperLib::ptClip, true);
+        clipper->AddPaths(holes, ClipperLib::ptClip, true);
         ClipperLib::PolyTree polytree;
-        clipper.Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        clipper->Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
         output = PolyTreeToExPolygons(std::move(polytree));
     }
 
@@ -1390,11 +1504,11 @@ Polygons variable_offset_outer(const ExPolygon &expoly, const std::vector<std::v
         output = std::move(contours);
     else {
         //FIXME the difference is not needed as the holes may never intersect with other holes.
-        ClipperLib::Clipper clipper;
-        clipper.Clear();
-        clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-        clipper.AddPaths(holes, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        ClipperUtils::ClipperScope clipper;
+        clipper->Clear();
+        clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+        clipper->AddPaths(holes, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     }
 
     return to_polygons(std::move(output));
@@ -1432,12 +1546,12 @@ ExPolygons variable_offset_outer_ex(const ExPolygon &expoly, const std::vector<s
         }
 	} else {
         //FIXME the difference is not needed as the holes may never intersect with other holes.
-		ClipperLib::Clipper clipper;
+		ClipperUtils::ClipperScope clipper;
         // Contours may have holes if they were created by closing a C shape.
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
 	    ClipperLib::PolyTree polytree;
-		clipper.Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		clipper->Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	    output = PolyTreeToExPolygons(std::move(polytree));
 	}
 
@@ -11,7 +11,10 @@
 #include <assert.h>
 #include <cstddef>
 #include <iterator>
+#include <memory>
 #include <utility>
+#include <type_traits>
+#include <variant>
 #include <vector>
 #include <cassert>
 
@@ -349,6 +352,31 @@ namespace ClipperUtils {
     [[nodiscard]] Polygons  clip_clipper_polygons_with_subject_bbox(const Polygons &src, const BoundingBox &bbox);
     [[nodiscard]] Polygons  clip_clipper_polygons_with_subject_bbox(const ExPolygon &src, const BoundingBox &bbox);
     [[nodiscard]] Polygons  clip_clipper_polygons_with_subject_bbox(const ExPolygons &src, const BoundingBox &bbox);
+
+    // Borrows the ClipperLib::Clipper or ClipperLib::ClipperOffset engine cached by the calling thread for the lifetime of the scope.
+    // The engine is cleared at the end of the scope, but its internal storage (edge arrays, local minima, output points, joins)
+    // stays allocated for the next boolean operation or offset of the same thread, thus a loop over layers or islands
+    // calling ClipperUtils does not allocate and release the same storage again and again.
+    // The engine is returned with default parameters. If the engine of the thread is already borrowed by an enclosing scope,
+    // a temporary engine is created instead.
+    template<typename Engine>
+    class EngineScope {
+    public:
+        EngineScope();
+        ~EngineScope();
+        EngineScope(const EngineScope&) = delete;
+        EngineScope& operator=(const EngineScope&) = delete;
+
+        Engine& operator*()  { return *m_engine; }
+        Engine* operator->() { return m_engine; }
+
+    private:
+        Engine                  *m_engine;
+        // Engine allocated for a nested scope.
+        std::unique_ptr<Engine>  m_temp;
+    };
+    using ClipperScope       = EngineScope<ClipperLib::Clipper>;
+    using ClipperOffsetScope = EngineScope<ClipperLib::ClipperOffset>;
 }
 
 // offset Polygons
@@ -550,6 +578,50 @@ Slic3r::Polygons union_parallel_reduce(const Slic3r::Polygons &subject);
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygon &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
 
+// Batch of independent boolean operations (difference, intersection, union, xor), each with its own subject and clip.
+// Calling diff() / intersection() many times on small inputs is dominated by the per call overhead, thus the batch
+// processes all its operations with the Clipper engine cached by the worker thread (see ClipperUtils::ClipperScope),
+// resolves intersections of inputs with disjoint bounding boxes without calling Clipper at all
+// and optionally processes the operations in parallel.
+// The inputs are referenced by the batch, they have to stay valid until execute() / execute_ex() returns.
+class ClipperBatch
+{
+public:
+    // Add a boolean operation, subject and clip may be Polygons, ExPolygon or ExPolygons.
+    // Returns the index of the operation, which is the index of its result in the vector returned by execute() / execute_ex().
+    template<typename TSubject, typename TClip>
+    size_t add(ClipperLib::ClipType type, const TSubject &subject, const TClip &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No) {
+        // Safety offset only allowed on intersection and difference.
+        assert(do_safety_offset == ApplySafetyOffset::No || type != ClipperLib::ctUnion);
+        m_operations.push_back({ type, Input(&subject), Input(&clip), do_safety_offset });
+        return m_operations.size() - 1;
+    }
+    // The batch only references its inputs, temporaries would dangle before execute() is called.
+    template<typename TSubject, typename TClip, typename = std::enable_if_t<! std::is_lvalue_reference_v<TSubject>>>
+    size_t add(ClipperLib::ClipType type, TSubject &&subject, const TClip &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No) = delete;
+    template<typename TSubject, typename TClip, typename = std::enable_if_t<! std::is_lvalue_reference_v<TClip>>>
+    size_t add(ClipperLib::ClipType type, const TSubject &subject, TClip &&clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No) = delete;
+
+    size_t                                  size() const { return m_operations.size(); }
+    bool                                    empty() const { return m_operations.empty(); }
+    void                                    clear() { m_operations.clear(); }
+
+    // Perform the operations, return one result per operation in the order of add() calls.
+    // Operations of a parallel batch are distributed among TBB worker threads.
+    [[nodiscard]] std::vector<Polygons>     execute(bool parallel = false) const;
+    [[nodiscard]] std::vector<ExPolygons>   execute_ex(bool parallel = false) const;
+
+private:
+    using Input = std::variant<const Polygons*, const ExPolygon*, const ExPolygons*>;
+    struct Operation {
+        ClipperLib::ClipType    type;
+        Input                   subject;
+        Input                   clip;
+        ApplySafetyOffset       do_safety_offset;
+    };
+    std::vector<Operation>      m_operations;
+};
+
 ClipperLib::PolyNodes order_nodes(const ClipperLib::PolyNodes &nodes);
 
 // Implementing generalized loop (foreach) over a list of nodes which can be
@@ -334,6 +334,49 @@ void EdgeGrid::Grid::create_from_m_contours(coord_t resolution)
 		for (visitor.j = 0; visitor.j < contour.num_segments(); ++ visitor.j)
 			this->visit_cells_intersecting_line(contour.segment_start(visitor.j), contour.segment_end(visitor.j), visitor);
 	}
+
+	// 7) Copy the end points of the segments referenced by m_cell_data into a structure of arrays for the distance queries.
+	m_cell_segments.start_x.resize(cnt);
+	m_cell_segments.start_y.resize(cnt);
+	m_cell_segments.end_x.resize(cnt);
+	m_cell_segments.end_y.resize(cnt);
+	for (size_t i = 0; i < cnt; ++ i) {
+		const auto [p1, p2] = this->segment(m_cell_data[i]);
+		m_cell_segments.start_x[i] = p1.x();
+		m_cell_segments.start_y[i] = p1.y();
+		m_cell_segments.end_x[i]   = p2.x();
+		m_cell_segments.end_y[i]   = p2.y();
+	}
+}
+
+// Number of segments of a cell, which distances to a point are evaluated at once.
+static constexpr size_t segment_distance_batch_size = 64;
+
+// Squared distances of pt to the segments [begin, begin + n) of the structure of arrays.
+// The loop has no branches, thus it is vectorized by the compiler. The distances are evaluated in doubles, therefore
+// they are just estimates of the exact distances calculated with 64bit integers, good enough to reject the segments
+// farther from pt than the closest segment found so far.
+static inline void segment_distances_squared(const coord_t *start_x, const coord_t *start_y, const coord_t *end_x, const coord_t *end_y,
+	size_t n, const Vec2d &pt, double *out)
+{
+	for (size_t i = 0; i < n; ++ i) {
+		const double vx = double(end_x[i]) - double(start_x[i]);
+		const double vy = double(end_y[i]) - double(start_y[i]);
+		const double wx = pt.x() - double(start_x[i]);
+		const double wy = pt.y() - double(start_y[i]);
+		const double l2 = vx * vx + vy * vy;
+		const double t  = std::min(std::max(vx * wx + vy * wy, 0.), l2) / std::max(l2, 1.);
+		const double dx = wx - t * vx;
+		const double dy = wy - t * vy;
+		out[i] = dx * dx + dy * dy;
+	}
+}
+
+// Segments with an estimated distance above this limit are farther from the point than d_min.
+// Allow for the rounding errors of the estimate.
+static inline double segment_distance_rejection_limit(double d_min)
+{
+	return sqr(d_min * (1. + 1e-9) + 1.);
 }
 
 #if 0
@@ -1081,11 +1124,23 @@ EdgeGrid::Grid::ClosestPointResult EdgeGrid::Grid::closest_point_signed_distance
 	double d_min = double(search_radius);
 	// Signum of the distance field at pt.
 	int sign_min = 0;
+	// Estimated squared distances to a batch of segments of a cell.
+	const Vec2d pt_d = pt.cast<double>();
+	double      dist2[segment_distance_batch_size];
 	double l2_seg_min = 1.;
 	for (int r = bbox.min(1); r <= bbox.max(1); ++ r) {
 		for (int c = bbox.min(0); c <= bbox.max(0); ++ c) {
 			const Cell &cell = m_cells[r * m_cols + c];
 			for (size_t i = cell.begin; i < cell.end; ++ i) {
+				const size_t batch_idx = (i - cell.begin) % segment_distance_batch_size;
+				if (batch_idx == 0)
+					// Estimate the distances to the next batch of segments of the cell at once.
+					segment_distances_squared(m_cell_segments.start_x.data() + i, m_cell_segments.start_y.data() + i,
+						m_cell_segments.end_x.data() + i, m_cell_segments.end_y.data() + i,
+						std::min(segment_distance_batch_size, cell.end - i), pt_d, dist2);
+				if (dist2[batch_idx] > segment_distance_rejection_limit(d_min))
+					// Farther than the closest segment found so far.
+					continue;
 				const size_t   contour_idx = m_cell_data[i].first;
 				const Contour &contour     = m_contours[contour_idx];
 				assert(contour.closed());
@@ -1211,11 +1266,23 @@ bool EdgeGrid::Grid::signed_distance_edges(const Point &pt, coord_t search_radiu
 	double d_min = double(search_radius);
 	// Signum of the distance field at pt.
 	int sign_min = 0;
+	// Estimated squared distances to a batch of segments of a cell.
+	const Vec2d pt_d = pt.cast<double>();
+	double      dist2[segment_distance_batch_size];
 	bool on_segment = false;
 	for (int r = bbox.min(1); r <= bbox.max(1); ++ r) {
 		for (int c = bbox.min(0); c <= bbox.max(0); ++ c) {
 			const Cell &cell = m_cells[r * m_cols + c];
 			for (size_t i = cell.begin; i < cell.end; ++ i) {
+				const size_t batch_idx = (i - cell.begin) % segment_distance_batch_size;
+				if (batch_idx == 0)
+					// Estimate the distances to the next batch of segments of the cell at once.
+					segment_distances_squared(m_cell_segments.start_x.data() + i, m_cell_segments.start_y.data() + i,
+						m_cell_segments.end_x.data() + i, m_cell_segments.end_y.data() + i,
+						std::min(segment_distance_batch_size, cell.end - i), pt_d, dist2);
+				if (dist2[batch_idx] > segment_distance_rejection_limit(d_min))
+					// Farther than the closest segment found so far.
+					continue;
 				const Contour &contour = m_contours[m_cell_data[i].first];
 				assert(contour.closed());
 				size_t ipt = m_cell_data[i].second;
@@ -412,6 +412,15 @@ protected:
 
 	// Referencing a contour and a line segment of m_contours.
 	std::vector<std::pair<size_t, size_t> >		m_cell_data;
+	// End points of the line segments referenced by m_cell_data, stored as a structure of arrays, so that the distance queries
+	// evaluate the distances to all segments of a cell in a batch, which the compiler vectorizes.
+	struct CellSegments {
+		std::vector<coord_t> 					start_x;
+		std::vector<coord_t> 					start_y;
+		std::vector<coord_t> 					end_x;
+		std::vector<coord_t> 					end_y;
+	};
+	CellSegments								m_cell_segments;
 
 	// Full grid of cells.
 	std::vector<Cell> 							m_cells;
@@ -5,6 +5,10 @@
 ///|/
 #include <cmath>
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <vector>
 #include <cstddef>
 
@@ -39,61 +43,69 @@ static inline double f(double x, double z_sin, double z_cos, bool vertical, bool
     }
 }
 
-static inline Polyline make_wave(
-    const std::vector<Vec2d>& one_period, double width, double height, double offset, double scaleFactor,
-    double z_cos, double z_sin, bool vertical, bool flip)
+// Evaluate f() for a batch of samples: y[i] = f(x[i]).
+// The branches of f() are hoisted out of the loops and the phase shifts by PI are folded into the sign of the second term,
+// thus the loops are straight line code over contiguous arrays, which the compiler may vectorize.
+static void f_batch(const double *x, double *y, size_t n, double z_sin, double z_cos, bool vertical, bool flip)
 {
-    std::vector<Vec2d> points = one_period;
-    double period = points.back()(0);
-    if (width != period) // do not extend if already truncated
-    {
-        points.reserve(one_period.size() * size_t(floor(width / period)));
-        points.pop_back();
-
-        size_t n = points.size();
-        do {
-            points.emplace_back(points[points.size()-n].x() + period, points[points.size()-n].y());
-        } while (points.back()(0) < width - EPSILON);
-
-        points.emplace_back(Vec2d(width, f(width, z_sin, z_cos, vertical, flip)));
-    }
-
-    // and construct the final polyline to return:
-    Polyline polyline;
-    polyline.points.reserve(points.size());
-    for (auto& point : points) {
-        point(1) += offset;
-        point(1) = std::clamp(double(point.y()), 0., height);
-        if (vertical)
-            std::swap(point(0), point(1));
-        polyline.points.emplace_back((point * scaleFactor).cast<coord_t>());
+    if (vertical) {
+        const double phase_offset = (z_cos < 0 ? M_PI : 0) + M_PI;
+        const double b2           = sqr(z_cos);
+        // cos(t + PI) = - cos(t)
+        const double res_scale    = flip ? - z_sin : z_sin;
+        for (size_t i = 0; i < n; ++ i) {
+            const double t   = x[i] + phase_offset;
+            const double a   = sin(t);
+            const double res = res_scale * cos(t);
+            const double r   = sqrt(sqr(a) + b2);
+            y[i] = asin(a / r) + asin(res / r) + M_PI;
+        }
+    } else {
+        const double phase_offset = z_sin < 0 ? M_PI : 0.;
+        const double b2           = sqr(z_sin);
+        // sin(t + PI) = - sin(t)
+        const double res_scale    = flip ? z_cos : - z_cos;
+        for (size_t i = 0; i < n; ++ i) {
+            const double t   = x[i] + phase_offset;
+            const double a   = cos(t);
+            const double res = res_scale * sin(t);
+            const double r   = sqrt(sqr(a) + b2);
+            y[i] = asin(a / r) + asin(res / r) + 0.5 * M_PI;
+        }
     }
-
-    return polyline;
 }
 
-static std::vector<Vec2d> make_one_period(double width, double scaleFactor, double z_cos, double z_sin, bool vertical, bool flip, double tolerance)
+static std::vector<Vec2d> make_one_period(double width, double z_cos, double z_sin, bool vertical, bool flip, double tolerance)
 {
     std::vector<Vec2d> points;
     double dx = M_PI_2; // exact coordinates on main inflexion lobes
     double limit = std::min(2*M_PI, width);
     points.reserve(coord_t(ceil(limit / tolerance / 3)));
 
-    for (double x = 0.; x < limit - EPSILON; x += dx) {
-        points.emplace_back(Vec2d(x, f(x, z_sin, z_cos, vertical, flip)));
-    }
-    points.emplace_back(Vec2d(limit, f(limit, z_sin, z_cos, vertical, flip)));
+    std::vector<double> xs;
+    for (double x = 0.; x < limit - EPSILON; x += dx)
+        xs.emplace_back(x);
+    xs.emplace_back(limit);
+    std::vector<double> ys(xs.size());
+    f_batch(xs.data(), ys.data(), xs.size(), z_sin, z_cos, vertical, flip);
+    for (size_t i = 0; i < xs.size(); ++ i)
+        points.emplace_back(xs[i], ys[i]);
 
     // piecewise increase in resolution up to requested tolerance
     for(;;)
     {
+        // Evaluate the midpoints of all the segments at once.
         size_t size = points.size();
-        for (unsigned int i = 1;i < size; ++i) {
-            auto& lp = points[i-1]; // left point
-            auto& rp = points[i];   // right point
-            double x = lp(0) + (rp(0) - lp(0)) / 2;
-            double y = f(x, z_sin, z_cos, vertical, flip);
-            Vec2d ip = {x, y};
+        xs.clear();
+        for (size_t i = 1; i < size; ++ i)
+            xs.emplace_back(points[i - 1].x() + (points[i].x() - points[i - 1].x()) / 2);
+        ys.resize(xs.size());
+        f_batch(xs.data(), ys.data(), xs.size(), z_sin, z_cos, vertical, flip);
+
+        for (size_t i = 1; i < size; ++ i) {
+            const Vec2d &lp = points[i-1]; // left point
+            const Vec2d &rp = points[i];   // right point
+            Vec2d ip = { xs[i - 1], ys[i - 1] };
             if (std::abs(cross2(Vec2d(ip - lp), Vec2d(ip - rp))) > sqr(tolerance)) {
                 points.emplace_back(std::move(ip));
             }
@@ -112,6 +124,93 @@ static std::vector<Vec2d> make_one_period(double width, double scaleFactor, doub
     return points;
 }
 
+namespace {
+
+// Odd and even waves of a single period of the gyroid at a single Z.
+struct GyroidPeriods
+{
+    std::vector<Vec2d> odd;
+    std::vector<Vec2d> even;
+};
+
+// The waves of a period depend on Z only through sin(Z) and cos(Z), thus they repeat with a period of 2 PI in Z
+// and they are the same for all the regions and islands filled at the same layer. Calculated periods are cached
+// and shared by all the threads filling the layers.
+class GyroidPeriodCache
+{
+public:
+    std::shared_ptr<const GyroidPeriods> get(double z, double scale_factor, double tolerance, double limit, bool vertical)
+    {
+        const Key key { z, scale_factor, tolerance, limit };
+        {
+            std::scoped_lock<std::mutex> lock(m_mutex);
+            if (auto it = m_cache.find(key); it != m_cache.end())
+                return it->second;
+        }
+        const double z_sin = sin(z);
+        const double z_cos = cos(z);
+        // Odd polylines are flipped for the horizontal waves, even polylines are a bit shifted.
+        const bool   flip  = ! vertical;
+        auto periods = std::make_shared<GyroidPeriods>();
+        periods->odd  = make_one_period(limit, z_cos, z_sin, vertical, flip, tolerance);
+        periods->even = make_one_period(limit, z_cos, z_sin, vertical, ! flip, tolerance);
+        {
+            std::scoped_lock<std::mutex> lock(m_mutex);
+            if (m_cache.size() >= MaxSize)
+                m_cache.clear();
+            m_cache.emplace(key, periods);
+        }
+        return periods;
+    }
+
+private:
+    // Limit of the number of cached periods, the cache is cleared when full.
+    static constexpr size_t MaxSize = 1024;
+
+    using Key = std::tuple<double, double, double, double>;
+    std::mutex                                                  m_mutex;
+    std::map<Key, std::shared_ptr<const GyroidPeriods>>         m_cache;
+};
+
+GyroidPeriodCache s_gyroid_period_cache;
+
+} // namespace
+
+// Tile one period of the wave over the whole width, the last point is evaluated exactly at the width.
+static std::vector<Vec2d> make_wave_template(const std::vector<Vec2d> &one_period, double width, double z_cos, double z_sin, bool vertical, bool flip)
+{
+    std::vector<Vec2d> points = one_period;
+    double period = points.back()(0);
+    if (width != period) // do not extend if already truncated
+    {
+        points.reserve(one_period.size() * size_t(floor(width / period) + 1));
+        points.pop_back();
+
+        size_t n = points.size();
+        do {
+            points.emplace_back(points[points.size()-n].x() + period, points[points.size()-n].y());
+        } while (points.back()(0) < width - EPSILON);
+
+        points.emplace_back(Vec2d(width, f(width, z_sin, z_cos, vertical, flip)));
+    }
+    return points;
+}
+
+static inline Polyline make_wave(const std::vector<Vec2d> &wave_template, double height, double offset, double scaleFactor, bool vertical)
+{
+    // and construct the final polyline to return:
+    Polyline polyline;
+    polyline.points.reserve(wave_template.size());
+    for (const Vec2d &template_point : wave_template) {
+        Vec2d point(template_point.x(), std::clamp(template_point.y() + offset, 0., height));
+        if (vertical)
+            std::swap(point(0), point(1));
+        polyline.points.emplace_back((point * scaleFactor).cast<coord_t>());
+    }
+
+    return polyline;
+}
+
 static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double line_spacing, double width, double height)
 {
     const double scaleFactor = scale_(line_spacing) / density_adjusted;
@@ -122,7 +221,8 @@ static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double
 
     //scale factor for 5% : 8 712 388
     // 1z = 10^-6 mm ?
-    const double z     = gridZ / scaleFactor;
+    // The pattern is periodic in Z, reduce Z to a single period to reuse the cached waves.
+    const double z     = fmod(gridZ / scaleFactor, 2. * M_PI);
     const double z_sin = sin(z);
     const double z_cos = cos(z);
 
@@ -137,18 +237,21 @@ static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double
         std::swap(width,height);
     }
 
-    std::vector<Vec2d> one_period_odd = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip, tolerance); // creates one period of the waves, so it doesn't have to be recalculated all the time
-    flip = !flip;                                                                   // even polylines are a bit shifted
-    std::vector<Vec2d> one_period_even = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip, tolerance);
+    // creates one period of the waves, so it doesn't have to be recalculated all the time
+    std::shared_ptr<const GyroidPeriods> periods = s_gyroid_period_cache.get(z, scaleFactor, tolerance, std::min(2*M_PI, width), vertical);
+    // even polylines are a bit shifted, the last point of both of them is calculated with the flip of the even polylines
+    flip = ! flip;
+    const std::vector<Vec2d> wave_odd  = make_wave_template(periods->odd,  width, z_cos, z_sin, vertical, flip);
+    const std::vector<Vec2d> wave_even = make_wave_template(periods->even, width, z_cos, z_sin, vertical, flip);
     Polylines result;
 
     for (double y0 = lower_bound; y0 < upper_bound + EPSILON; y0 += M_PI) {
         // creates odd polylines
-        result.emplace_back(make_wave(one_period_odd, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
+        result.emplace_back(make_wave(wave_odd, height, y0, scaleFactor, vertical));
         // creates even polylines
         y0 += M_PI;
         if (y0 < upper_bound + EPSILON) {
-            result.emplace_back(make_wave(one_period_even, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
+            result.emplace_back(make_wave(wave_even, height, y0, scaleFactor, vertical));
         }
     }
 
@@ -13,6 +13,7 @@
 #include "libslic3r/Zipper.hpp"
 #include "libslic3r/SLAPrint.hpp"
 #include "libslic3r/Exception.hpp"
+#include "libslic3r/I18N.hpp"
 #include "libslic3r/MTUtils.hpp"
 #include "libslic3r/PrintConfig.hpp"
 
@@ -524,7 +525,9 @@ std::unique_ptr<sla::RasterBase> SL1Archive::create_raster() const
 
     double gamma = m_cfg.gamma_correction.getFloat();
 
-    return sla::create_raster_grayscale_aa(res, pxdim, gamma, tr);
+    // Most of a layer is usually empty, thus only the runs of the rows are kept
+    // instead of the whole bitmap.
+    return sla::create_raster_grayscale_aa(res, pxdim, gamma, tr, sla::RasterStorage::RunLength);
 }
 
 sla::RasterEncoder SL1Archive::get_encoder() const
@@ -576,14 +579,28 @@ void SL1Archive::export_print(Zipper               &zipper,
         zipper.add_entry("config.json");
         zipper << to_json(print, iniconf);
 
-        size_t i = 0;
-        for (const sla::EncodedRaster &rst : m_layers) {
-
-            std::string imgname = project + string_printf("%.5d", i++) + "." +
-                                  rst.extension();
-
-            zipper.add_entry(imgname.c_str(), rst.data(), rst.size());
-        }
+        // The layers are rasterized and compressed in parallel while being written into the archive
+        // in order, thus only a few of the layers are kept in memory at once.
+        const size_t num_layers = print.print_layers().size();
+        int          last_percent = -1;
+        draw_and_write_layers(num_layers,
+            [&print](sla::RasterBase &raster, size_t idx) { print.draw_layer(raster, idx); },
+            [&zipper, &project](sla::EncodedRaster &&rst, size_t idx) {
+                std::string imgname = project + string_printf("%.5d", int(idx)) + "." +
+                                      rst.extension();
+
+                zipper.add_entry(imgname.c_str(), rst.data(), rst.size());
+            },
+            [&print]() {
+                if (print.canceled())
+                    throw CanceledException();
+            },
+            [&print, num_layers, &last_percent](size_t num_written) {
+                if (int percent = int(num_written * 100 / num_layers); percent != last_percent) {
+                    last_percent = percent;
+                    print.set_status(percent, _u8L("Exporting the layers"));
+                }
+            });
 
         for (const ThumbnailData& data : thumbnails)
             if (data.is_valid())
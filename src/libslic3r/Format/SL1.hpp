@@ -36,6 +36,9 @@ public:
     explicit SL1Archive(const SLAPrinterConfig &cfg): m_cfg(cfg) {}
     explicit SL1Archive(SLAPrinterConfig &&cfg): m_cfg(std::move(cfg)) {}
 
+    // The layers are rasterized when exporting, see export_print(Zipper &, ...).
+    bool streams_layers() const override { return true; }
+
     void export_print(const std::string     fname,
                       const SLAPrint       &print,
                       const ThumbnailsList &thumbnails,
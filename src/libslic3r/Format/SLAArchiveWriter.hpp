@@ -16,6 +16,15 @@
 #include "libslic3r/GCode/ThumbnailData.hpp"
 #include "libslic3r/Execution/Execution.hpp"
 
+#if ! defined(TBB_VERSION_MAJOR)
+    #include <tbb/version.h>
+#endif
+#if TBB_VERSION_MAJOR >= 2021
+    #include <tbb/parallel_pipeline.h>
+#else
+    #include <tbb/pipeline.h>
+#endif
+
 namespace Slic3r {
 
 class SLAPrint;
@@ -28,6 +37,49 @@ protected:
     virtual std::unique_ptr<sla::RasterBase> create_raster() const = 0;
     virtual sla::RasterEncoder get_encoder() const = 0;
 
+    // Rasterize and encode the layers in parallel, while passing the encoded layers to writefn
+    // serially and in the order of the layers. Only a bounded number of layers is in flight,
+    // thus the memory consumption does not grow with the number of layers.
+    // Fn have to be thread safe: void(sla::RasterBase& raster, size_t lyrid);
+    // WriteFn is called from a single thread at a time: void(sla::EncodedRaster &&rst, size_t lyrid);
+    // ThrowOnCancelFn is called before each layer is started: void();
+    // StatusFn is called after each layer is written, from a single thread at a time: void(size_t num_layers_written);
+    template<class Fn, class WriteFn, class ThrowOnCancelFn, class StatusFn>
+    void draw_and_write_layers(size_t layer_num, Fn &&drawfn, WriteFn &&writefn, ThrowOnCancelFn &&throw_on_cancel, StatusFn &&statusfn)
+    {
+#if TBB_VERSION_MAJOR >= 2021
+        using filtermode = tbb::filter_mode;
+#else
+        using filtermode = tbb::filter;
+#endif
+        struct EncodedLayer {
+            size_t             idx;
+            sla::EncodedRaster raster;
+        };
+        size_t next_idx = 0;
+        const auto source = tbb::make_filter<void, size_t>(filtermode::serial_in_order,
+            [&next_idx, layer_num, &throw_on_cancel](tbb::flow_control &fc) -> size_t {
+                throw_on_cancel();
+                if (next_idx == layer_num) {
+                    fc.stop();
+                    return 0;
+                }
+                return next_idx ++;
+            });
+        const auto encoder = tbb::make_filter<size_t, EncodedLayer>(filtermode::parallel,
+            [this, &drawfn](size_t idx) -> EncodedLayer {
+                auto rst = create_raster();
+                drawfn(*rst, idx);
+                return { idx, rst->encode(get_encoder()) };
+            });
+        const auto writer = tbb::make_filter<EncodedLayer, void>(filtermode::serial_in_order,
+            [&writefn, &statusfn](EncodedLayer layer) {
+                writefn(std::move(layer.raster), layer.idx);
+                statusfn(layer.idx + 1);
+            });
+        tbb::parallel_pipeline(2 * tbb::this_task_arena::max_concurrency(), source & encoder & writer);
+    }
+
 public:
     virtual ~SLAArchiveWriter() = default;
 
@@ -53,6 +105,10 @@ public:
             execution::max_concurrency(ep));
     }
 
+    // If true, draw_layers() is not called when slicing, the layers are rasterized and encoded
+    // by export_print() through draw_and_write_layers() straight into the archive.
+    virtual bool streams_layers() const { return false; }
+
     // Export the print into an archive using the provided filename.
     virtual void export_print(const std::string     fname,
                               const SLAPrint       &print,
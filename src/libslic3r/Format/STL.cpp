@@ -7,12 +7,26 @@
 ///|/
 ///|/ PrusaSlicer is released under the terms of the AGPLv3 or higher
 ///|/
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/predef/other/endian.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_sort.h>
+#include <ankerl/unordered_dense.h>
 #include <string>
 #include <utility>
 #include <cstring>
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <limits>
 
 #include "libslic3r/Model.hpp"
 #include "libslic3r/TriangleMesh.hpp"
+#include "admesh/stl.h"
 #include "STL.hpp"
 
 #ifdef _WIN32
@@ -23,10 +37,211 @@
 
 namespace Slic3r {
 
+namespace {
+
+struct VertexHash {
+    size_t operator()(const Vec3f &v) const { return ankerl::unordered_dense::detail::wyhash::hash(v.data(), sizeof(Vec3f)); }
+};
+
+// Merging of vertices is split into buckets by the vertex hash, the buckets are processed in parallel.
+static constexpr const size_t num_vertex_buckets = 256;
+
+// Bits of the hash used to select the bucket. ankerl::unordered_dense uses the lowest byte of the hash as a fingerprint
+// and the highest bits as the index into the hash table, thus the bucket is selected by neither of them.
+inline size_t vertex_bucket(size_t hash) { return (hash >> 8) & (num_vertex_buckets - 1); }
+
+} // namespace
+
+// Load a binary STL from a memory mapped file directly into an indexed_triangle_set, merging vertices with exactly the same
+// coordinates in parallel. Compared to admesh stl_open() / stl_generate_shared_vertices(), neither the whole file
+// nor the array of stl_facet is held in memory.
+// Returns false if the file is not a binary STL or if it contains invalid coordinates.
+static bool load_stl_binary_indexed(const char *path, indexed_triangle_set &out)
+{
+#if BOOST_ENDIAN_BIG_BYTE
+    // The memory mapped data would have to be byte swapped.
+    return false;
+#else
+    boost::iostreams::mapped_file_source file;
+    try {
+        boost::system::error_code ec;
+        const boost::uintmax_t file_size = boost::filesystem::file_size(path, ec);
+        if (ec || file_size < STL_MIN_FILE_SIZE || (file_size - HEADER_SIZE) % SIZEOF_STL_FACET != 0)
+            return false;
+        file.open(boost::filesystem::path(path));
+    } catch (const std::exception &) {
+        return false;
+    }
+    if (! file.is_open())
+        return false;
+
+    // Same test for a binary STL as the one of admesh.
+    const auto *data = reinterpret_cast<const unsigned char*>(file.data());
+    if (std::none_of(data + HEADER_SIZE, data + HEADER_SIZE + 128, [](unsigned char c) { return c > 127; }))
+        return false;
+
+    const size_t num_facets  = (file.size() - HEADER_SIZE) / SIZEOF_STL_FACET;
+    const size_t num_corners = 3 * num_facets;
+    if (num_corners > size_t(std::numeric_limits<int>::max()))
+        return false;
+    auto corner_vertex = [data](size_t corner) {
+        Vec3f v;
+        // Skip the header and the facet normal.
+        memcpy(v.data(), data + HEADER_SIZE + (corner / 3) * SIZEOF_STL_FACET + 3 * sizeof(float) + (corner % 3) * sizeof(Vec3f), sizeof(Vec3f));
+        // Turn negative zeros into positive zeros, so that they are merged when hashing the binary representation.
+        return Vec3f(v.array() + 0.f);
+    };
+
+    // Facets are processed in a fixed number of chunks. Each chunk counts its corners falling into each bucket,
+    // the counts are then turned into the chunk's output offsets per bucket and the chunks fill in the buckets in parallel.
+    // Thus the corners of each bucket are sorted and the result does not depend on scheduling of the worker threads.
+    const size_t num_chunks  = std::clamp<size_t>(num_facets / 65536, 1, 64);
+    auto         chunk_range = [num_corners, num_chunks](size_t chunk_id) {
+        return std::make_pair(num_corners / 3 * chunk_id / num_chunks * 3, num_corners / 3 * (chunk_id + 1) / num_chunks * 3);
+    };
+    std::vector<uint8_t> corner_buckets(num_corners);
+    std::vector<size_t>  chunk_offsets(num_chunks * num_vertex_buckets, 0);
+    std::atomic<bool>    valid { true };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+        [&corner_vertex, &chunk_range, &corner_buckets, &chunk_offsets, &valid](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_id = range.begin(); chunk_id < range.end(); ++ chunk_id) {
+                auto [chunk_begin, chunk_end] = chunk_range(chunk_id);
+                size_t *counts = chunk_offsets.data() + chunk_id * num_vertex_buckets;
+                for (size_t corner = chunk_begin; corner < chunk_end; ++ corner) {
+                    const Vec3f v = corner_vertex(corner);
+                    if (! std::isfinite(v.x()) || ! std::isfinite(v.y()) || ! std::isfinite(v.z())) {
+                        valid = false;
+                        return;
+                    }
+                    const size_t bucket = vertex_bucket(VertexHash{}(v));
+                    corner_buckets[corner] = uint8_t(bucket);
+                    ++ counts[bucket];
+                }
+            }
+        });
+    if (! valid)
+        return false;
+
+    std::vector<size_t> bucket_begin(num_vertex_buckets + 1, 0);
+    {
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < num_vertex_buckets; ++ bucket) {
+            bucket_begin[bucket] = offset;
+            for (size_t chunk_id = 0; chunk_id < num_chunks; ++ chunk_id) {
+                size_t &chunk_offset = chunk_offsets[chunk_id * num_vertex_buckets + bucket];
+                size_t  count        = chunk_offset;
+                chunk_offset = offset;
+                offset      += count;
+            }
+        }
+        bucket_begin.back() = offset;
+    }
+    std::vector<int> bucket_corners(num_corners);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+        [&chunk_range, &corner_buckets, &chunk_offsets, &bucket_corners](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_id = range.begin(); chunk_id < range.end(); ++ chunk_id) {
+                auto [chunk_begin, chunk_end] = chunk_range(chunk_id);
+                size_t *offsets = chunk_offsets.data() + chunk_id * num_vertex_buckets;
+                for (size_t corner = chunk_begin; corner < chunk_end; ++ corner)
+                    bucket_corners[offsets[corner_buckets[corner]] ++] = int(corner);
+            }
+        });
+
+    // Merge the vertices of each bucket, store the index of the vertex into its bucket into out.indices.
+    out.indices.assign(num_facets, stl_triangle_vertex_indices(-1, -1, -1));
+    std::vector<std::vector<Vec3f>> bucket_vertices(num_vertex_buckets);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertex_buckets, 1),
+        [&corner_vertex, &bucket_begin, &bucket_corners, &bucket_vertices, &out](const tbb::blocked_range<size_t> &range) {
+            ankerl::unordered_dense::map<Vec3f, int, VertexHash> vertex_ids;
+            for (size_t bucket = range.begin(); bucket < range.end(); ++ bucket) {
+                std::vector<Vec3f> &vertices = bucket_vertices[bucket];
+                vertex_ids.clear();
+                for (size_t i = bucket_begin[bucket]; i < bucket_begin[bucket + 1]; ++ i) {
+                    const int   corner = bucket_corners[i];
+                    const Vec3f v      = corner_vertex(corner);
+                    auto [it, inserted] = vertex_ids.try_emplace(v, int(vertices.size()));
+                    if (inserted)
+                        vertices.emplace_back(v);
+                    out.indices[corner / 3][corner % 3] = it->second;
+                }
+            }
+        });
+    bucket_corners = {};
+    file.close();
+
+    // Number the vertices in the order of their first use by the triangles, so that the vertices of neighbor triangles are stored close to each other.
+    std::vector<int> bucket_vertex_begin(num_vertex_buckets + 1, 0);
+    for (size_t bucket = 0; bucket < num_vertex_buckets; ++ bucket)
+        bucket_vertex_begin[bucket + 1] = bucket_vertex_begin[bucket] + int(bucket_vertices[bucket].size());
+    std::vector<int> vertex_map(bucket_vertex_begin.back(), -1);
+    out.vertices.clear();
+    out.vertices.reserve(vertex_map.size());
+    for (size_t facet_idx = 0; facet_idx < num_facets; ++ facet_idx) {
+        stl_triangle_vertex_indices &facet = out.indices[facet_idx];
+        for (int i = 0; i < 3; ++ i) {
+            const size_t bucket = corner_buckets[facet_idx * 3 + i];
+            int         &id     = vertex_map[bucket_vertex_begin[bucket] + facet(i)];
+            if (id == -1) {
+                id = int(out.vertices.size());
+                out.vertices.emplace_back(bucket_vertices[bucket][facet(i)]);
+            }
+            facet(i) = id;
+        }
+    }
+    return true;
+#endif
+}
+
+// Cheap test for open edges before its_repair(): each edge of a closed mesh is shared by an even number of faces,
+// whatever their orientation. Degenerate faces are skipped, they are removed by its_repair().
+static bool has_unpaired_edges(const indexed_triangle_set &its)
+{
+    std::vector<uint64_t> edges;
+    edges.reserve(its.indices.size() * 3);
+    for (const stl_triangle_vertex_indices &face : its.indices)
+        if (face(0) != face(1) && face(0) != face(2) && face(1) != face(2))
+            for (int i = 0; i < 3; ++ i) {
+                const int a = face(i);
+                const int b = face(i == 2 ? 0 : i + 1);
+                edges.emplace_back((uint64_t(std::min(a, b)) << 32) | uint64_t(std::max(a, b)));
+            }
+    tbb::parallel_sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i + 1;
+        for (; j < edges.size() && edges[j] == edges[i]; ++ j) ;
+        if ((j - i) & 1)
+            return true;
+        i = j;
+    }
+    return false;
+}
+
+// Load a binary STL into a mesh and repair it with its_repair(), bypassing admesh if the repaired mesh is closed.
+// Otherwise false is returned and the caller shall load the file with admesh, which closes open edges by merging nearby vertices.
+static bool load_stl_binary_indexed(const char *path, TriangleMesh &mesh)
+{
+    indexed_triangle_set its;
+    if (! load_stl_binary_indexed(path, its))
+        return false;
+    // Open meshes (typically scans) are common, don't waste time and memory on repairing a mesh, which would be thrown away.
+    if (has_unpaired_edges(its))
+        return false;
+    RepairedMeshErrors errors = its_repair(its);
+    TriangleMesh out(std::move(its), errors);
+    // its_face_neighbors() only connects triangles sharing an edge with opposite orientations,
+    // thus a mesh with no open edges is closed and consistently oriented.
+    if (out.stats().open_edges > 0)
+        return false;
+    mesh = std::move(out);
+    return true;
+}
+
 bool load_stl(const char *path, Model *model, const char *object_name_in)
 {
     TriangleMesh mesh;
-    if (! mesh.ReadSTLFile(path)) {
+    if (load_stl_binary_indexed(path, mesh))
+        BOOST_LOG_TRIVIAL(debug) << "load_stl: " << path << " loaded as a closed binary STL without admesh";
+    else if (! mesh.ReadSTLFile(path)) {
 //    die "Failed to open $file\n" if !-e $path;
         return false;
     }
@@ -1617,8 +1617,13 @@ void GCodeGenerator::process_layers(
         [find_replace = this->m_find_replace.get()](std::string s) -> std::string {
             return find_replace->process_layer(std::move(s));
         });
-    const auto output = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
-        [&output_stream](std::string s) { output_stream.write(s); }
+    const auto output = tbb::make_filter<std::string, std::string>(slic3r_tbb_filtermode::serial_in_order,
+        [&output_stream](std::string s) -> std::string { output_stream.write_no_processor(s); return s; }
+    );
+    // The G-code processor runs on its own serial stage, thus the time estimation and move extraction
+    // of one layer overlaps with writing the next layer into the file.
+    const auto processor = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
+        [&output_stream](std::string s) { output_stream.process(s); }
     );
 
     tbb::filter<void, LayerResult> pipeline_to_layerresult = smooth_path_interpolator & generator;
@@ -1636,7 +1641,7 @@ void GCodeGenerator::process_layers(
     TBBLocalesSetter locales_setter;
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output & processor);
     output_stream.find_replace_enable();
 }
 
@@ -1710,8 +1715,13 @@ void GCodeGenerator::process_layers(
         [find_replace = this->m_find_replace.get()](std::string s) -> std::string {
             return find_replace->process_layer(std::move(s));
         });
-    const auto output = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
-        [&output_stream](std::string s) { output_stream.write(s); }
+    const auto output = tbb::make_filter<std::string, std::string>(slic3r_tbb_filtermode::serial_in_order,
+        [&output_stream](std::string s) -> std::string { output_stream.write_no_processor(s); return s; }
+    );
+    // The G-code processor runs on its own serial stage, thus the time estimation and move extraction
+    // of one layer overlaps with writing the next layer into the file.
+    const auto processor = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
+        [&output_stream](std::string s) { output_stream.process(s); }
     );
 
     tbb::filter<void, LayerResult> pipeline_to_layerresult = smooth_path_interpolator & generator;
@@ -1729,7 +1739,7 @@ void GCodeGenerator::process_layers(
     TBBLocalesSetter locales_setter;
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output & processor);
     output_stream.find_replace_enable();
 }
 
@@ -3270,6 +3280,18 @@ void GCodeGenerator::GCodeOutputStream::write(const char *what)
     }
 }
 
+void GCodeGenerator::GCodeOutputStream::write_no_processor(std::string &what)
+{
+    if (m_find_replace)
+        what = m_find_replace->process_layer(std::move(what));
+    fwrite(what.c_str(), 1, what.size(), this->f);
+}
+
+void GCodeGenerator::GCodeOutputStream::process(const std::string &what)
+{
+    m_processor.process_buffer(what);
+}
+
 void GCodeGenerator::GCodeOutputStream::writeln(const std::string &what)
 {
     if (! what.empty())
@@ -198,6 +198,13 @@ private:
         // Write a string into a file.
         void write(const std::string& what) { this->write(what.c_str()); }
         void write(const char* what);
+        // Write a string into a file without passing it to the G-code processor.
+        // The string is modified in place by the find-replace post-processor if enabled,
+        // so that the very same G-code may be passed to process() later.
+        // Used by process_layers() to run the G-code processor as a separate pipeline stage.
+        void write_no_processor(std::string &what);
+        // Pass a string to the G-code processor without writing it into the file.
+        void process(const std::string &what);
 
         // Write a string into a file. 
         // Add a newline, if the string does not end with a newline already.
@@ -602,7 +602,7 @@ bool GCodeProcessor::contains_reserved_tag(const std::string& gcode, std::string
 
     GCodeReader parser;
     parser.parse_buffer(gcode, [&ret, &found_tag](GCodeReader& parser, const GCodeReader::GCodeLine& line) {
-        std::string comment = line.raw();
+        std::string_view comment = line.raw_view();
         if (comment.length() > 2 && comment.front() == ';') {
             comment = comment.substr(1);
             for (const std::string& s : Reserved_Tags) {
@@ -629,13 +629,13 @@ bool GCodeProcessor::contains_reserved_tags(const std::string& gcode, unsigned i
 
     GCodeReader parser;
     parser.parse_buffer(gcode, [&ret, &found_tag, max_count](GCodeReader& parser, const GCodeReader::GCodeLine& line) {
-        std::string comment = line.raw();
+        std::string_view comment = line.raw_view();
         if (comment.length() > 2 && comment.front() == ';') {
             comment = comment.substr(1);
             for (const std::string& s : Reserved_Tags) {
                 if (boost::starts_with(comment, s)) {
                     ret = true;
-                    found_tag.push_back(comment);
+                    found_tag.emplace_back(comment);
                     if (found_tag.size() == max_count) {
                         parser.quit_parsing();
                         return;
@@ -1208,7 +1208,9 @@ void GCodeProcessor::process_ascii_file(const std::string& filename, GCodeReader
     initialize_result_moves();
     size_t parse_line_callback_cntr = 10000;
     m_parser.set_progress_callback(progress_callback);
-    m_parser.parse_file(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
+    // The file is memory mapped and tokenized in parallel in chunks split at the layer change tags,
+    // only the stateful processing of the tokenized lines runs serially.
+    m_parser.parse_file_parallel(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
         if (-- parse_line_callback_cntr == 0) {
             // Don't call the cancel_callback() too often, do it every at every 10000'th line.
             parse_line_callback_cntr = 10000;
@@ -1216,7 +1218,7 @@ void GCodeProcessor::process_ascii_file(const std::string& filename, GCodeReader
                 cancel_callback();
         }
         this->process_gcode_line(line, true);
-    }, m_result.lines_ends);
+    }, m_result.lines_ends, ";" + reserved_tag(ETags::Layer_Change));
 
     // Don't post-process the G-code to update time stamps.
     this->finalize(false);
@@ -1866,7 +1868,10 @@ void GCodeProcessor::process_gcode_line(const GCodeReader::GCodeLine& line, bool
         }
     } else {
         // Leading whitespace is trimmed so that tags inside indented blocks (e.g. {if}) are recognized.
-        const std::string comment = boost::algorithm::trim_left_copy(line.raw());
+        // The raw line is not copied, it is referenced from the G-code buffer.
+        std::string_view comment = line.raw_view();
+        while (! comment.empty() && std::isspace(static_cast<unsigned char>(comment.front())))
+            comment.remove_prefix(1);
         if (comment.length() > 2 && comment.front() == ';') {
             // Process tags embedded into comments. Tag comments always start at the start of a line
             // with a comment and continue with a tag without any whitespace separator.
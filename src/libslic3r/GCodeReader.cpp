@@ -4,8 +4,13 @@
 ///|/
 #include "GCodeReader.hpp"
 
-#include <boost/nowide/cstdio.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 #include <fast_float.h>
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 #include <cassert>
@@ -13,9 +18,11 @@
 #include <cstdlib>
 
 #include "Utils.hpp"
+#include "Thread.hpp"
 #include "libslic3r/PrintConfig.hpp"
 #include "libslic3r/libslic3r.h"
 
+
 namespace Slic3r {
 
 static inline char get_extrusion_axis_char(const GCodeConfig &config)
@@ -39,6 +46,25 @@ void GCodeReader::apply_config(const DynamicPrintConfig &config)
 }
 
 const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command)
+{
+    const char *c = this->tokenize_line(ptr, end, gline, command);
+
+    if (gline.has(E) && m_config.use_relative_e_distances)
+        m_position[E] = 0;
+
+    // Skip the trailing newlines. A memory mapped file may end with a lone '\r', which must not be read past.
+	if (c != end && *c == '\r')
+		++ c;
+	if (c != end && *c == '\n')
+		++ c;
+
+    if (m_verbose)
+        std::cout << gline.raw_view() << std::endl;
+
+    return c;
+}
+
+const char* GCodeReader::tokenize_line(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command) const
 {
     assert(is_decimal_separator_point());
     
@@ -91,24 +117,12 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
         }
     }
     
-    if (gline.has(E) && m_config.use_relative_e_distances)
-        m_position[E] = 0;
-
     // Skip the rest of the line.
     for (; ! is_end_of_line(*c); ++ c);
 
-    // Copy the raw string including the comment, without the trailing newlines.
+    // Reference the raw string including the comment, without the trailing newlines.
     if (c > ptr)
-        gline.m_raw.assign(ptr, c);
-
-    // Skip the trailing newlines.
-	if (*c == '\r')
-		++ c;
-	if (*c == '\n')
-		++ c;
-
-    if (m_verbose)
-        std::cout << gline.m_raw << std::endl;
+        gline.set_raw(std::string_view(ptr, c - ptr));
 
     return c;
 }
@@ -126,65 +140,66 @@ void GCodeReader::update_coordinates(GCodeLine &gline, std::pair<const char*, co
     }
 }
 
+// Memory map a file for reading. Returns false if the file could not be opened or mapped.
+// An empty file cannot be memory mapped, it is left unmapped (file.is_open() == false) and true is returned.
+static bool map_file(const std::string &filename, boost::iostreams::mapped_file_source &file)
+{
+    boost::system::error_code ec;
+    const boost::uintmax_t file_size = boost::filesystem::file_size(filename, ec);
+    if (ec)
+        return false;
+    if (file_size == 0)
+        return true;
+    try {
+        file.open(boost::filesystem::path(filename));
+    } catch (const std::exception &) {
+        return false;
+    }
+    return file.is_open();
+}
+
 template<typename ParseLineCallback, typename LineEndCallback>
 bool GCodeReader::parse_file_raw_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback)
 {
-    FilePtr in{ boost::nowide::fopen(filename.c_str(), "rb") };
-
-    fseek(in.f, 0, SEEK_END);
-    const long file_size = ftell(in.f);
-    rewind(in.f);
-
-    // Read the input stream 64kB at a time, extract lines and process them.
-    std::vector<char> buffer(65536 * 10, 0);
-    // Line buffer.
-    std::string gcode_line;
-    size_t file_pos = 0;
+    // The file is memory mapped and the lines are passed to the callback without copying.
+    boost::iostreams::mapped_file_source file;
+    if (! map_file(filename, file))
+        return false;
+    if (! file.is_open())
+        // Empty file.
+        return true;
+
+    // Report progress every 640kB.
+    static constexpr const size_t progress_step = 65536 * 10;
+    const char  *data          = file.data();
+    const char  *data_end      = data + file.size();
+    const char  *ptr           = data;
+    size_t       next_progress = progress_step;
     m_parsing = true;
-    for (;;) {
-        size_t cnt_read = ::fread(buffer.data(), 1, buffer.size(), in.f);
-        if (::ferror(in.f))
-            return false;
-
-        bool eof       = cnt_read == 0;
-        auto it        = buffer.begin();
-        auto it_bufend = buffer.begin() + cnt_read;
-        while (it != it_bufend || (eof && ! gcode_line.empty())) {
-            // Find end of line.
-            bool eol    = false;
-            auto it_end = it;
-            for (; it_end != it_bufend && ! (eol = *it_end == '\r' || *it_end == '\n'); ++ it_end)
-                if (*it_end == '\n')
-                    line_end_callback(file_pos + (it_end - buffer.begin()) + 1);
-            // End of line is indicated also if end of file was reached.
-            eol |= eof && it_end == it_bufend;
-            if (eol) {
-                if (gcode_line.empty())
-                    parse_line_callback(&(*it), &(*it_end));
-                else {
-                    gcode_line.insert(gcode_line.end(), it, it_end);
-                    parse_line_callback(gcode_line.c_str(), gcode_line.c_str() + gcode_line.size());
-                    gcode_line.clear();
-                }
-                if (! m_parsing)
-                    // The callback wishes to exit.
-                    return true;
-            } else
-                gcode_line.insert(gcode_line.end(), it, it_end);
-            // Skip EOL.
-            it = it_end; 
-            if (it != it_bufend && *it == '\r')
-                ++ it;
-            if (it != it_bufend && *it == '\n') {
-                line_end_callback(file_pos + (it - buffer.begin()) + 1);
-                ++ it;
-            }
+    while (ptr != data_end) {
+        // Find end of line.
+        const char *eol = ptr;
+        for (; eol != data_end && *eol != '\r' && *eol != '\n'; ++ eol);
+        if (eol == data_end) {
+            // Last line of the file not terminated by a newline. The memory mapped file cannot be
+            // dereferenced past its end, thus copy the line into a zero terminated string.
+            std::string gcode_line(ptr, eol);
+            parse_line_callback(gcode_line.c_str(), gcode_line.c_str() + gcode_line.size());
+        } else
+            parse_line_callback(ptr, eol);
+        if (! m_parsing)
+            // The callback wishes to exit.
+            return true;
+        // Skip EOL.
+        ptr = eol;
+        if (ptr != data_end && *ptr == '\r')
+            ++ ptr;
+        if (ptr != data_end && *ptr == '\n')
+            line_end_callback(size_t(++ ptr - data));
+        if (m_progress_callback != nullptr && size_t(ptr - data) >= next_progress) {
+            m_progress_callback(static_cast<float>(ptr - data) / static_cast<float>(file.size()));
+            next_progress += progress_step;
         }
-        if (eof)
-            break;
-        file_pos += cnt_read;
-        if (m_progress_callback != nullptr)
-            m_progress_callback(static_cast<float>(file_pos) / static_cast<float>(file_size));
     }
     return true;
 }
@@ -213,6 +228,139 @@ bool GCodeReader::parse_file(const std::string& file, callback_t callback, std::
     return this->parse_file_internal(file, callback, [&lines_ends](size_t file_pos) { lines_ends.front().emplace_back(file_pos); });
 }
 
+bool GCodeReader::parse_file_parallel(const std::string &filename, callback_t callback, std::vector<std::vector<size_t>> &lines_ends, std::string_view split_marker)
+{
+    lines_ends.clear();
+    lines_ends.push_back(std::vector<size_t>());
+
+    boost::iostreams::mapped_file_source file;
+    if (! map_file(filename, file))
+        return false;
+    if (! file.is_open())
+        // Empty file.
+        return true;
+
+    // Lines of a chunk of the file tokenized by a worker thread.
+    struct Chunk {
+        std::vector<GCodeLine> lines;
+        // File positions just after each '\n' of the chunk.
+        std::vector<size_t>    lines_ends;
+        size_t                 end { 0 };
+    };
+
+    static constexpr const size_t chunk_size = 1024 * 1024;
+    const char        *data = file.data();
+    const size_t       size = file.size();
+
+    // Split the file into chunks, preferably just before a line starting with the split marker.
+    std::vector<std::pair<size_t, size_t>> ranges;
+    {
+        const std::string split_pattern = split_marker.empty() ? std::string() : "\n" + std::string(split_marker);
+        for (size_t begin = 0; begin < size;) {
+            size_t end = begin + chunk_size;
+            if (end >= size)
+                end = size;
+            else {
+                size_t split = std::string::npos;
+                if (! split_pattern.empty())
+                    // Look ahead at most one more chunk for the split marker.
+                    split = std::string_view(data + end, std::min(size - end, chunk_size)).find(split_pattern);
+                if (split != std::string::npos)
+                    end += split + 1;
+                else if (const char *eol = static_cast<const char*>(memchr(data + end, '\n', size - end)); eol)
+                    end = eol - data + 1;
+                else
+                    end = size;
+            }
+            ranges.emplace_back(begin, end);
+            begin = end;
+        }
+    }
+
+    auto tokenize = [this, data](std::pair<size_t, size_t> range, Chunk &chunk) {
+        chunk.lines.clear();
+        chunk.lines_ends.clear();
+        chunk.end = range.second;
+        const char *ptr = data + range.first;
+        const char *end = data + range.second;
+        std::pair<const char*, const char*> command;
+        while (ptr != end) {
+            const char *eol = ptr;
+            for (; eol != end && *eol != '\r' && *eol != '\n'; ++ eol);
+            GCodeLine &gline = chunk.lines.emplace_back();
+            if (eol == end) {
+                // Last line of the file not terminated by a newline. The memory mapped file cannot be
+                // dereferenced past its end, thus copy the line into a zero terminated string
+                // and let the GCodeLine own a copy of it.
+                std::string line(ptr, eol);
+                this->tokenize_line(line.c_str(), line.c_str() + line.size(), gline, command);
+                gline.raw();
+            } else
+                this->tokenize_line(ptr, eol, gline, command);
+            // Skip the trailing newlines the same way parse_line_internal() does.
+            ptr = eol;
+            if (ptr != end && *ptr == '\r')
+                ++ ptr;
+            if (ptr != end && *ptr == '\n')
+                chunk.lines_ends.emplace_back(++ ptr - data);
+        }
+    };
+
+    // Batches of chunks are tokenized on the TBB worker threads, while the previous batch is processed
+    // on the calling thread. The callbacks (line callback, progress callback) are thus never called
+    // from a worker thread, as they may update the UI.
+    const size_t       batch_size = 2 * size_t(tbb::this_task_arena::max_concurrency());
+    std::vector<Chunk> batch, next_batch;
+    auto tokenize_batch = [&ranges, &tokenize, batch_size](size_t first_range, std::vector<Chunk> &chunks) {
+        chunks.resize(std::min(batch_size, ranges.size() - first_range));
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size(), 1), [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                tokenize(ranges[first_range + i], chunks[i]);
+        });
+    };
+
+    // The tokenizer may depend on numeric locales being set to "C" on the TBB worker threads.
+    TBBLocalesSetter locales_setter;
+    m_parsing = true;
+    if (! ranges.empty())
+        tokenize_batch(0, batch);
+    tbb::task_group task_group;
+    try {
+        for (size_t first_range = 0; first_range < ranges.size(); first_range += batch_size) {
+            const size_t next_range = first_range + batch_size;
+            if (next_range < ranges.size())
+                task_group.run([&tokenize_batch, &next_batch, next_range]() { tokenize_batch(next_range, next_batch); });
+            for (Chunk &chunk : batch) {
+                for (GCodeLine &gline : chunk.lines) {
+                    if (gline.has(E) && m_config.use_relative_e_distances)
+                        m_position[E] = 0;
+                    callback(*this, gline);
+                    const std::string_view cmd = gline.cmd();
+                    std::pair<const char*, const char*> command { cmd.data(), cmd.data() + cmd.size() };
+                    this->update_coordinates(gline, command);
+                    if (! m_parsing) {
+                        // The callback wishes to exit.
+                        task_group.cancel();
+                        task_group.wait();
+                        return true;
+                    }
+                }
+                append(lines_ends.front(), std::move(chunk.lines_ends));
+                if (m_progress_callback != nullptr)
+                    m_progress_callback(static_cast<float>(chunk.end) / static_cast<float>(size));
+            }
+            task_group.wait();
+            std::swap(batch, next_batch);
+        }
+    } catch (...) {
+        // The callback threw, for example when canceled. Don't leave the tokenizing tasks running on the stack variables.
+        task_group.cancel();
+        task_group.wait();
+        throw;
+    }
+    return true;
+}
+
 bool GCodeReader::parse_file_raw(const std::string &filename, raw_line_callback_t line_callback)
 {
     return this->parse_file_raw_internal(filename,
@@ -244,13 +392,13 @@ const char* GCodeReader::axis_pos(const char *raw_str, char axis)
 
 bool GCodeReader::GCodeLine::has(char axis) const
 {
-    return GCodeReader::axis_pos(this->raw().c_str(), axis);
+    return GCodeReader::axis_pos(this->raw_view().data(), axis);
 }
 
 std::string_view GCodeReader::GCodeLine::axis_pos(char axis) const
 { 
-    const std::string &s = this->raw();
-    const char *c = GCodeReader::axis_pos(this->raw().c_str(), axis);
+    const std::string_view s = this->raw_view();
+    const char *c = GCodeReader::axis_pos(s.data(), axis);
     return c ? std::string_view{ c, s.size() - (c - s.data()) } : std::string_view();
 }
 
@@ -313,16 +461,19 @@ void GCodeReader::GCodeLine::set(const GCodeReader &reader, const Axis axis, con
         match[1] = reader.extrusion_axis();
     }
 
+    // Modify the owned copy of the raw line.
+    this->raw();
+    std::string &raw = m_raw_storage;
     if (this->has(axis)) {
-        size_t pos = m_raw.find(match)+2;
-        size_t end = m_raw.find(' ', pos+1);
-        m_raw = m_raw.replace(pos, end-pos, ss.str());
+        size_t pos = raw.find(match)+2;
+        size_t end = raw.find(' ', pos+1);
+        raw.replace(pos, end-pos, ss.str());
     } else {
-        size_t pos = m_raw.find(' ');
+        size_t pos = raw.find(' ');
         if (pos == std::string::npos)
-            m_raw += std::string(match) + ss.str();
+            raw += std::string(match) + ss.str();
         else
-            m_raw = m_raw.replace(pos, 0, std::string(match) + ss.str());
+            raw.replace(pos, 0, std::string(match) + ss.str());
     }
     m_axis[axis] = new_value;
     m_mask |= 1 << int(axis);
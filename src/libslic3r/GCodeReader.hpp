@@ -27,18 +27,30 @@ class GCodeReader {
 public:
     typedef std::function<void(float)> ProgressCallback;
 
+    // A single parsed G-code line. The raw line is not copied, it is a view into the buffer being parsed
+    // (a memory mapped file, a string or a line buffer), which is only valid during the parser callback.
+    // The character following the view is always an end of line character ('\r', '\n' or zero).
+    // The raw line is copied into an owned string only if requested through raw() or if the line is modified.
     class GCodeLine {
     public:
         GCodeLine() { reset(); }
-        void reset() { m_mask = 0; memset(m_axis, 0, sizeof(m_axis)); m_raw.clear(); }
-
-        const std::string&      raw() const { return m_raw; }
+        void reset() { m_mask = 0; memset(m_axis, 0, sizeof(m_axis)); m_raw = {}; m_raw_storage.clear(); m_raw_owned = true; }
+
+        // Copy of the raw line owned by this GCodeLine. Prefer raw_view() to avoid the copy.
+        const std::string&      raw() const {
+            if (! m_raw_owned) {
+                m_raw_storage.assign(m_raw.data(), m_raw.size());
+                m_raw_owned = true;
+            }
+            return m_raw_storage;
+        }
+        std::string_view        raw_view() const { return m_raw_owned ? std::string_view(m_raw_storage) : m_raw; }
         const std::string_view  cmd() const { 
-            const char *cmd = GCodeReader::skip_whitespaces(m_raw.c_str());
+            const char *cmd = GCodeReader::skip_whitespaces(this->raw_view().data());
             return std::string_view(cmd, GCodeReader::skip_word(cmd) - cmd);
         }
         const std::string_view  comment() const
-            { size_t pos = m_raw.find(';'); return (pos == std::string::npos) ? std::string_view() : std::string_view(m_raw).substr(pos + 1); }
+            { std::string_view raw = this->raw_view(); size_t pos = raw.find(';'); return (pos == std::string_view::npos) ? std::string_view() : raw.substr(pos + 1); }
 
         // Return position in this->raw() string starting with the "axis" character.
         std::string_view axis_pos(char axis) const;
@@ -66,7 +78,7 @@ public:
             float y = this->has(Y) ? (this->y() - reader.y()) : 0;
             return sqrt(x*x + y*y);
         }
-        bool cmd_is(const char *cmd_test)          const { return cmd_is(m_raw, cmd_test); }
+        bool cmd_is(const char *cmd_test)          const { return cmd_is(this->raw_view().data(), cmd_test); }
         bool extruding(const GCodeReader &reader)  const { return this->cmd_is("G1") && this->dist_E(reader) > 0; }
         bool retracting(const GCodeReader &reader) const { return this->cmd_is("G1") && this->dist_E(reader) < 0; }
         bool travel()     const { return this->cmd_is("G1") && ! this->has(E); }
@@ -84,8 +96,9 @@ public:
         float e() const { return m_axis[E]; }
         float f() const { return m_axis[F]; }
 
-        static bool cmd_is(const std::string &gcode_line, const char *cmd_test) {
-            const char *cmd = GCodeReader::skip_whitespaces(gcode_line.c_str());
+        static bool cmd_is(const std::string &gcode_line, const char *cmd_test) { return cmd_is(gcode_line.c_str(), cmd_test); }
+        static bool cmd_is(const char *gcode_line, const char *cmd_test) {
+            const char *cmd = GCodeReader::skip_whitespaces(gcode_line);
             size_t len = strlen(cmd_test); 
             return strncmp(cmd, cmd_test, len) == 0 && GCodeReader::is_end_of_word(cmd[len]);
         }
@@ -96,13 +109,20 @@ public:
 
         static std::string extract_cmd(const std::string& gcode_line) {
             GCodeLine temp;
-            temp.m_raw = gcode_line;
+            temp.set_raw(gcode_line);
             const std::string_view cmd = temp.cmd();
             return { cmd.begin(), cmd.end() };
         }
 
     private:
-        std::string      m_raw;
+        // Point the raw line to an external buffer, which has to be followed by an end of line character.
+        void set_raw(std::string_view raw) { m_raw = raw; m_raw_storage.clear(); m_raw_owned = false; }
+
+        // View into the buffer being parsed, valid if ! m_raw_owned.
+        std::string_view m_raw;
+        // Owned copy of the raw line, valid if m_raw_owned.
+        mutable std::string m_raw_storage;
+        mutable bool     m_raw_owned;
         float            m_axis[NUM_AXES];
         uint32_t         m_mask;
         friend class GCodeReader;
@@ -151,6 +171,11 @@ public:
     // Collect positions of line ends in the binary G-code to be used by the G-code viewer when memory mapping and displaying section of G-code
     // as an overlay in the 3D scene.
     bool parse_file(const std::string& file, callback_t callback, std::vector<std::vector<size_t>>& lines_ends);
+    // Memory map the G-code file, tokenize its lines in parallel in chunks and call the callback for each line serially
+    // in the order of the file. The callback and the progress callback are called from the calling thread only.
+    // Chunks are preferably split at lines starting with split_marker (for example a layer change tag).
+    // Collects positions of line ends the same way as parse_file() above. Returns false if reading the file failed.
+    bool parse_file_parallel(const std::string &file, callback_t callback, std::vector<std::vector<size_t>> &lines_ends, std::string_view split_marker = {});
     // Just read the G-code file line by line, calls callback (const char *begin, const char *end). Returns false if reading the file failed.
     bool parse_file_raw(const std::string &file, raw_line_callback_t callback);
 
@@ -183,6 +208,9 @@ private:
     bool        parse_file_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
 
     const char* parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
+    // Parse the command and axes of a single line without updating the reader state. Returns the end of the line
+    // (the first newline or zero character). Thread safe, used by parse_file_parallel() on worker threads.
+    const char* tokenize_line(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command) const;
     void        update_coordinates(GCodeLine &gline, std::pair<const char*, const char*> &command);
 
     static bool         is_whitespace(char c)           { return c == ' ' || c == '\t'; }
@@ -795,6 +795,124 @@ void Layer::make_perimeters()
     BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id() << " - Done";
 }
 
+// Regions of layers of the same PrintObject are shared, regions of a PrintObject replaced by a new PrintObject
+// are compared by their configuration.
+static inline bool same_print_region(const PrintRegion &l, const PrintRegion &r)
+{
+    return &l == &r || l == r;
+}
+
+static bool same_surfaces(const SurfaceCollection &l, const SurfaceCollection &r)
+{
+    if (l.size() != r.size())
+        return false;
+    for (size_t i = 0; i < l.size(); ++ i) {
+        const Surface &sl = l.surfaces[i];
+        const Surface &sr = r.surfaces[i];
+        if (sl.surface_type != sr.surface_type || sl.extra_perimeters != sr.extra_perimeters || sl.thickness != sr.thickness ||
+            sl.thickness_layers != sr.thickness_layers || sl.bridge_angle != sr.bridge_angle || sl.expolygon != sr.expolygon)
+            return false;
+    }
+    return true;
+}
+
+// Call fn(layerm, other_layerm) for the regions present in both layers, test that the regions present in just one of the layers are empty.
+template<typename Fn>
+static bool layer_regions_all_of(const LayerRegionPtrs &regions, const LayerRegionPtrs &other_regions, Fn fn)
+{
+    for (size_t region_id = 0; region_id < std::max(regions.size(), other_regions.size()); ++ region_id) {
+        const LayerRegion *layerm       = region_id < regions.size() ? regions[region_id] : nullptr;
+        const LayerRegion *other_layerm = region_id < other_regions.size() ? other_regions[region_id] : nullptr;
+        if (layerm == nullptr || other_layerm == nullptr) {
+            // For example a region of a modifier added to the object or removed from the object.
+            if (! (layerm ? layerm : other_layerm)->slices().empty())
+                return false;
+        } else if (! same_print_region(layerm->region(), other_layerm->region()) || ! fn(*layerm, *other_layerm))
+            return false;
+    }
+    return true;
+}
+
+bool Layer::has_same_perimeter_inputs(const Layer &other) const
+{
+    // The perimeter generator treats the first object layer (no overhangs, single perimeter on the first layer, brim) differently.
+    const size_t raft_layers = size_t(m_object->config().raft_layers.value);
+    if (m_id <= raft_layers || other.m_id <= raft_layers)
+        return false;
+    if (this->height != other.height ||
+        ! layer_regions_all_of(m_regions, other.m_regions, [](const LayerRegion &layerm, const LayerRegion &other_layerm) {
+            return same_surfaces(layerm.slices(), other_layerm.slices());
+        }))
+        return false;
+
+    // Overhangs are detected against the layer below, top surfaces against the layer above.
+    auto same_neighbor = [](const Layer *l, const Layer *r) {
+        return l == nullptr ? r == nullptr : r != nullptr && l->lslices == r->lslices;
+    };
+    return this->lslices.size() == other.lslices.size() &&
+           same_neighbor(this->lower_layer, other.lower_layer) && same_neighbor(this->upper_layer, other.upper_layer);
+}
+
+void Layer::copy_perimeters_from(const Layer &other)
+{
+    assert(this->has_same_perimeter_inputs(other));
+    assert(this->lslices_ex.size() == other.lslices_ex.size());
+
+    for (size_t region_id = 0; region_id < m_regions.size(); ++ region_id) {
+        LayerRegion &layerm = *m_regions[region_id];
+        layerm.m_fills.clear();
+        if (region_id < other.m_regions.size()) {
+            const LayerRegion &other_layerm = *other.m_regions[region_id];
+            layerm.m_perimeters                       = other_layerm.m_perimeters;
+            layerm.m_thin_fills                       = other_layerm.m_thin_fills;
+            layerm.m_fill_expolygons                  = other_layerm.m_fill_expolygons;
+            layerm.m_fill_expolygons_bboxes           = other_layerm.m_fill_expolygons_bboxes;
+            layerm.m_fill_expolygons_composite        = other_layerm.m_fill_expolygons_composite;
+            layerm.m_fill_expolygons_composite_bboxes = other_layerm.m_fill_expolygons_composite_bboxes;
+        } else {
+            // Empty region missing in the other layer.
+            layerm.m_perimeters.clear();
+            layerm.m_thin_fills.clear();
+            layerm.m_fill_expolygons.clear();
+            layerm.m_fill_expolygons_bboxes.clear();
+            layerm.m_fill_expolygons_composite.clear();
+            layerm.m_fill_expolygons_composite_bboxes.clear();
+        }
+    }
+
+    // The islands reference the extrusions and the fill expolygons of the layer regions by indices, thus they are valid for the copies.
+    for (size_t i = 0; i < this->lslices_ex.size(); ++ i)
+        this->lslices_ex[i].islands = other.lslices_ex[i].islands;
+}
+
+bool Layer::has_same_fill_inputs(const Layer &other) const
+{
+    return m_id == other.m_id && std::abs(this->print_z - other.print_z) < EPSILON && this->lslices_ex.size() == other.lslices_ex.size() &&
+        layer_regions_all_of(m_regions, other.m_regions, [](const LayerRegion &layerm, const LayerRegion &other_layerm) {
+            return same_surfaces(layerm.fill_surfaces(), other_layerm.fill_surfaces()) && layerm.fill_expolygons() == other_layerm.fill_expolygons();
+        });
+}
+
+void Layer::copy_fills_from(const Layer &other)
+{
+    assert(this->has_same_fill_inputs(other));
+
+    for (size_t region_id = 0; region_id < m_regions.size(); ++ region_id) {
+        LayerRegion &layerm = *m_regions[region_id];
+        if (region_id < other.m_regions.size())
+            layerm.m_fills = other.m_regions[region_id]->m_fills;
+        else
+            layerm.m_fills.clear();
+    }
+
+    // The perimeters were copied from the other layer, thus the islands of both layers are the same.
+    for (size_t i = 0; i < this->lslices_ex.size(); ++ i) {
+        assert(this->lslices_ex[i].islands.size() == other.lslices_ex[i].islands.size());
+        for (size_t j = 0; j < this->lslices_ex[i].islands.size(); ++ j)
+            this->lslices_ex[i].islands[j].fills = other.lslices_ex[i].islands[j].fills;
+    }
+}
+
 void Layer::sort_perimeters_into_islands(
     // Slices for which perimeters and fill_expolygons were just created.
     // The slices may have been created by merging multiple source slices with the same perimeter parameters.
@@ -221,6 +221,21 @@ public:
         return false;
     }
     void                    make_perimeters();
+    // Test whether make_perimeters() of this layer produces the same extrusions as make_perimeters() of the other layer:
+    // Both layers have to be of the same height, their PrintRegions have to be shared or configured the same with the same slices
+    // and the layers below and above have to have the same lslices. A region missing in one of the layers has to be empty in the other.
+    // The other layer may belong to a PrintObject replaced by the PrintObject of this layer.
+    // Layers, which perimeters depend on the layer index (the first object layer), are never reused.
+    bool                    has_same_perimeter_inputs(const Layer &other) const;
+    // Copy the result of make_perimeters() from another layer with the same perimeter inputs instead of generating the perimeters again.
+    // The extrusions are planar, thus they are valid for this layer without any modification.
+    void                    copy_perimeters_from(const Layer &other);
+    // Test whether make_fills() of this layer, which perimeters were copied from the other layer, produces the same extrusions
+    // as make_fills() of the other layer: Both layers have to be at the same print_z with the same index and their regions
+    // have to have the same fill surfaces. Infill generated for the object as a whole (lightning, adaptive cubic) is not considered.
+    bool                    has_same_fill_inputs(const Layer &other) const;
+    // Copy the result of make_fills() from another layer with the same fill inputs.
+    void                    copy_fills_from(const Layer &other);
     void                    make_fills(FillAdaptive::Octree     *adaptive_fill_octree,
                                        FillAdaptive::Octree     *support_fill_octree,
                                        FillLightning::Generator *lightning_generator);
@@ -671,6 +671,10 @@ void LayerRegion::process_external_surfaces(const Layer *lower_layer, const Poly
             std::vector<BoundingBox> fill_boundaries_ex_bboxes = get_extents_vector(fill_boundaries_ex);
             bridges_grown.reserve(bridges.size());
             bridge_bboxes.reserve(bridges.size());
+            // There are often many small bridges, thus the trimming of the bridges by their islands is batched.
+            // The batch references bridges_grown, which was reserved above and it is not reallocated.
+            ClipperBatch             trim_batch;
+            std::vector<size_t>      trim_idx(bridges.size(), size_t(-1));
             for (size_t i = 0; i < bridges.size(); ++ i) {
                 // Find the island of this bridge.
                 const Point pt = bridges[i].expolygon.contour.points.front();
@@ -682,16 +686,20 @@ void LayerRegion::process_external_surfaces(const Layer *lower_layer, const Poly
                         break;
                     }
                 // Grown by 3mm.
-                Polygons polys = offset(bridges[i].expolygon, margin, EXTERNAL_SURFACES_OFFSET_PARAMETERS);
+                bridges_grown.push_back(offset(bridges[i].expolygon, margin, EXTERNAL_SURFACES_OFFSET_PARAMETERS));
                 if (idx_island == -1) {
 				    BOOST_LOG_TRIVIAL(trace) << "Bridge did not fall into the source region!";
                 } else {
                     // Found an island, to which this bridge region belongs. Trim the expanded bridging region
                     // with its source region, so it does not overflow into a neighbor region.
-                    polys = intersection(polys, fill_boundaries_ex[idx_island]);
+                    trim_idx[i] = trim_batch.add(ClipperLib::ctIntersection, bridges_grown.back(), fill_boundaries_ex[idx_island]);
                 }
-                bridge_bboxes.push_back(get_extents(polys));
-                bridges_grown.push_back(std::move(polys));
+            }
+            std::vector<Polygons> trimmed = trim_batch.execute();
+            for (size_t i = 0; i < bridges.size(); ++ i) {
+                if (trim_idx[i] != size_t(-1))
+                    bridges_grown[i] = std::move(trimmed[trim_idx[i]]);
+                bridge_bboxes.push_back(get_extents(bridges_grown[i]));
             }
         }
 
@@ -70,6 +70,7 @@ void Print::clear()
 	m_objects.clear();
     m_print_regions.clear();
     m_model.clear_objects();
+    m_volume_slices_cache.clear();
 }
 
 // Called by Print::apply().
@@ -908,6 +909,7 @@ void Print::process()
     name_tbb_thread_pool_threads_set_locale();
 
     BOOST_LOG_TRIVIAL(info) << "Starting the slicing process." << log_memory_info();
+    PrintProfiler::Scope profile(m_profiler, "print", "Process");
 
     tbb::parallel_for(tbb::blocked_range<size_t>(0, m_objects.size(), 1), [this](const tbb::blocked_range<size_t> &range) {
         for (size_t idx = range.begin(); idx < range.end(); ++idx) {
@@ -934,6 +936,7 @@ void Print::process()
     }, tbb::simple_partitioner());
 
     if (this->set_started(psWipeTower)) {
+        PrintProfiler::Scope profile(m_profiler, "print", "Wipe tower");
         m_wipe_tower_data.clear();
         m_tool_ordering.clear();
         if (this->has_wipe_tower()) {
@@ -948,6 +951,7 @@ void Print::process()
         this->set_done(psWipeTower);
     }
     if (this->set_started(psSkirtBrim)) {
+        PrintProfiler::Scope profile(m_profiler, "print", "Skirt and brim");
         this->set_status(88, _u8L("Generating skirt and brim"));
 
         m_skirt.clear();
@@ -1020,7 +1024,10 @@ std::string Print::export_gcode(const std::string& path_template, GCodeProcessor
 
     // Create GCode on heap, it has quite a lot of data.
     std::unique_ptr<GCodeGenerator> gcode(new GCodeGenerator(const_cast<const Print*>(this)));
-    gcode->do_export(this, path.c_str(), result, thumbnail_cb);
+    {
+        PrintProfiler::Scope profile(m_profiler, "print", "Export G-code");
+        gcode->do_export(this, path.c_str(), result, thumbnail_cb);
+    }
 
     if (m_conflict_result.has_value())
         result->conflict_result = *m_conflict_result;
@@ -32,6 +32,7 @@
 #include "Slicing.hpp"
 #include "SupportSpotsGenerator.hpp"
 #include "TriangleMeshSlicer.hpp"
+#include "VolumeSlicesCache.hpp"
 #include "libslic3r/GCode/ToolOrdering.hpp"
 #include "libslic3r/GCode/WipeTower.hpp"
 #include "libslic3r/GCode/ThumbnailData.hpp"
@@ -419,6 +420,34 @@ private:
     // Called on main thread with stopped or paused background processing to let PrintObject release data for its milestones that were invalidated or canceled.
     void                    cleanup();
 
+    // Layers of a PrintObject, which was replaced by a new PrintObject, because just the modifier volumes or the layer ranges
+    // of its ModelObject changed. Perimeters and infill of the layers outside of the Z range touched by the change are copied
+    // to the layers of the new PrintObject instead of being generated again, if their inputs are found to be the same.
+    struct ReusableLayers {
+        ~ReusableLayers();
+        LayerPtrs                                                   layers;
+        // Regions of the replaced PrintObject referenced by the layers above.
+        std::shared_ptr<std::vector<std::unique_ptr<PrintRegion>>>  regions;
+        // Configuration of the replaced PrintObject.
+        PrintObjectConfig                                           config;
+        // Z range touched by the change in unscaled coordinates of the PrintObject.
+        t_layer_height_range                                        dirty_z_range;
+        // Slices of the layers were split into top / internal / bottom surfaces by prepare_infill().
+        bool                                                        typed_slices { false };
+        // Infill of the layers is valid.
+        bool                                                        fills_valid { false };
+        // Layer the perimeters of a layer of the new PrintObject were copied from, indexed by the layer index. Filled in by make_perimeters()
+        // by keep_perimeters_sources(). Owned by this structure, infill() releases each of them once the infill of its layer is done.
+        std::vector<const Layer*>                                   perimeters_sources;
+
+        // Release the layers, which the perimeters were not copied from, keep the others as perimeters_sources.
+        void                                                        keep_perimeters_sources(std::vector<const Layer*> &&sources);
+    };
+    // Take out the layers with valid perimeters before this PrintObject is invalidated and deleted. Returns null if the perimeters are not valid.
+    std::unique_ptr<ReusableLayers> release_reusable_layers(std::shared_ptr<std::vector<std::unique_ptr<PrintRegion>>> regions, const t_layer_height_range &dirty_z_range);
+    // Hand over layers of the replaced PrintObject with the same transformation.
+    void                    set_reusable_layers(std::unique_ptr<ReusableLayers> &&reusable_layers);
+
     static PrintObjectConfig object_config_from_model_object(
         const PrintObjectConfig& default_object_config,
         const ModelObject& object,
@@ -435,6 +464,8 @@ private:
     void generate_support_material();
     void estimate_curled_extrusions();
     void calculate_overhanging_perimeters();
+    // Measures a step or a single layer of a step of this object, see PrintBase::profiler().
+    PrintProfiler::Scope profile_scope(const char *category, const char *name, int layer_id = -1);
 
     void slice_volumes();
     // Has any support (not counting the raft).
@@ -446,6 +477,8 @@ private:
     void discover_horizontal_shells();
     void combine_infill();
     void _generate_support_material();
+    // For each layer, a layer of m_reusable_layers with the same print_z outside of the Z range touched by the change of modifiers.
+    std::vector<Layer*> match_reusable_layers();
     std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> prepare_adaptive_infill_data(
         const std::vector<std::pair<const Surface*, float>>& surfaces_w_bottom_z) const;
     FillLightning::GeneratorPtr prepare_lightning_infill_data();
@@ -475,6 +508,9 @@ private:
 
     std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> m_adaptive_fill_octrees;
     FillLightning::GeneratorPtr m_lightning_generator;
+
+    // Layers of the PrintObject replaced by this one, released as soon as they are known not to be reused.
+    std::unique_ptr<ReusableLayers>         m_reusable_layers;
 };
 
 
@@ -792,6 +828,9 @@ private:
     // Estimated print time, filament consumed.
     PrintStatistics                         m_print_statistics;
 
+    // Slices of ModelVolumes reused by PrintObject::slice() of PrintObjects recreated by Print::apply().
+    VolumeSlicesCache                       m_volume_slices_cache;
+
     // To allow GCode to set the Print's GCodeExport step status.
     friend class GCodeGenerator;
     // To allow GCodeProcessor to emit warnings.
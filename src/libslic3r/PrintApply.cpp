@@ -8,6 +8,7 @@
 #include <cmath>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -204,6 +205,50 @@ static bool layer_height_ranges_equal(const t_layer_config_ranges &lr1, const t_
     return true;
 }
 
+// Z range in the coordinate system of a PrintObject with the given trafo touched by the modifier volumes added, removed,
+// transformed or reordered and by the layer ranges added or removed. Returns an empty range (first > second) if none of them changed.
+static t_layer_height_range modifiers_changed_z_range(const ModelObject &model_object_old, const ModelObject &model_object_new, const Transform3d &trafo)
+{
+    t_layer_height_range out { std::numeric_limits<coordf_t>::max(), std::numeric_limits<coordf_t>::lowest() };
+    auto extend = [&out](coordf_t z_min, coordf_t z_max) {
+        out.first  = std::min(out.first,  z_min);
+        out.second = std::max(out.second, z_max);
+    };
+
+    auto modifiers = [](const ModelObject &model_object) {
+        ModelVolumePtrs out;
+        for (ModelVolume *model_volume : model_object.volumes)
+            if (model_volume->is_modifier())
+                out.emplace_back(model_volume);
+        return out;
+    };
+    const ModelVolumePtrs modifiers_old = modifiers(model_object_old);
+    const ModelVolumePtrs modifiers_new = modifiers(model_object_new);
+    auto extend_by_changed_modifiers = [&extend, &trafo](const ModelVolumePtrs &volumes, const ModelVolumePtrs &other_volumes) {
+        for (size_t i = 0; i < volumes.size(); ++ i) {
+            const ModelVolume &model_volume = *volumes[i];
+            // The later modifier overrides the former one, thus a modifier moved in the list is considered changed.
+            if (i < other_volumes.size() && other_volumes[i]->id() == model_volume.id() && other_volumes[i]->get_matrix().isApprox(model_volume.get_matrix()))
+                continue;
+            const BoundingBoxf3 bbox = model_volume.mesh().transformed_bounding_box(trafo * model_volume.get_matrix());
+            extend(bbox.min.z(), bbox.max.z());
+        }
+    };
+    extend_by_changed_modifiers(modifiers_old, modifiers_new);
+    extend_by_changed_modifiers(modifiers_new, modifiers_old);
+
+    auto extend_by_changed_ranges = [&extend](const t_layer_config_ranges &ranges, const t_layer_config_ranges &other_ranges) {
+        for (const auto &range : ranges)
+            if (std::none_of(other_ranges.begin(), other_ranges.end(), [&range](const auto &other_range) {
+                    return std::abs(range.first.first - other_range.first.first) < EPSILON && std::abs(range.first.second - other_range.first.second) < EPSILON;
+                }))
+                extend(range.first.first, range.first.second);
+    };
+    extend_by_changed_ranges(model_object_old.layer_config_ranges, model_object_new.layer_config_ranges);
+    extend_by_changed_ranges(model_object_new.layer_config_ranges, model_object_old.layer_config_ranges);
+    return out;
+}
+
 // Returns true if va == vb when all CustomGCode items that are not the specified type (not_ignore_type) are ignored.
 static bool custom_per_printz_gcodes_tool_changes_differ(
     const std::vector<CustomGCode::Item> &va,
@@ -1404,6 +1449,14 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                                           model_volume_list_changed(model_object, model_object_new, ModelVolumeType::SUPPORT_ENFORCER);
         bool layer_height_ranges_differ = ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, model_object_new.layer_height_profile.empty());
         bool model_origin_translation_differ = model_object.origin_translation != model_object_new.origin_translation;
+        // Just the modifier volumes or the layer ranges may have changed. Layers outside of the Z range touched by the change
+        // may then reuse perimeters and infill of the PrintObjects being replaced.
+        bool only_modifiers_differ      = ! model_origin_translation_differ && ! virtual_extruders_differ &&
+                                          model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile) &&
+                                          ! model_volume_list_changed(model_object, model_object_new, { ModelVolumeType::MODEL_PART, ModelVolumeType::NEGATIVE_VOLUME }) &&
+                                          ! model_mmu_segmentation_data_changed(model_object, model_object_new) &&
+                                          ! (model_object_new.is_mm_painted() && num_extruders_changed) &&
+                                          ! model_fuzzy_skin_data_changed(model_object, model_object_new);
         auto print_objects_range        = print_object_status_db.get_range(model_object);
         // The list actually can be empty if all instances are out of the print bed.
         //assert(print_objects_range.begin() != print_objects_range.end());
@@ -1421,6 +1474,16 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                 ModelObjectStatus::PrintObjectRegionsStatus::Invalid :
                 // Reuse bounding boxes of print_objects_regions for ModelVolumes with unmodified transformation.
                 ModelObjectStatus::PrintObjectRegionsStatus::PartiallyValid;
+            if (only_modifiers_differ && model_object_status.print_object_regions != nullptr) {
+                // Stop background processing before taking the layers out of the PrintObjects.
+                this->call_cancel_callback();
+                // The layers reference the regions, keep them alive until the layers are released.
+                auto regions = std::make_shared<std::vector<std::unique_ptr<PrintRegion>>>(std::move(model_object_status.print_object_regions->all_regions));
+                model_object_status.print_object_regions->all_regions.clear();
+                for (const PrintObjectStatus &print_object_status : print_objects_range)
+                    print_object_status.print_object->m_reusable_layers = print_object_status.print_object->release_reusable_layers(
+                        regions, modifiers_changed_z_range(model_object, model_object_new, print_object_status.trafo));
+            }
             for (const PrintObjectStatus &print_object_status : print_objects_range) {
                 update_apply_status(print_object_status.print_object->invalidate_all_steps());
                 const_cast<PrintObjectStatus&>(print_object_status).status = PrintObjectStatus::Deleted;
@@ -1532,11 +1595,21 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                     PrintObject::object_config_from_model_object(m_default_object_config, *model_object, num_physical_extruders));
                 print_object_last = print_object;
             };
+            // Hand over the layers of a replaced PrintObject with the same transformation matrix.
+            auto print_object_reuse_layers = [&print_object_status_db, model_object](PrintObject *print_object) {
+                for (const PrintObjectStatus &print_object_status : print_object_status_db.get_range(*model_object))
+                    if (print_object_status.status == PrintObjectStatus::Deleted && print_object_status.print_object->m_reusable_layers &&
+                        transform3d_equal(print_object_status.trafo, print_object->trafo())) {
+                        print_object->set_reusable_layers(std::move(print_object_status.print_object->m_reusable_layers));
+                        break;
+                    }
+            };
             if (old.empty()) {
                 // Simple case, just generate new instances.
                 for (PrintObjectTrafoAndInstances &print_instances : model_object_status.print_instances) {
                     PrintObject *print_object = new PrintObject(this, model_object, print_instances.trafo, std::move(print_instances.instances));
                     print_object_apply_config(print_object);
+                    print_object_reuse_layers(print_object);
                     print_objects_new.emplace_back(print_object);
                     // print_object_status.emplace(PrintObjectStatus(print_object, PrintObjectStatus::New));
                     new_objects = true;
@@ -1554,6 +1627,7 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                     // This is a new instance (or a set of instances with the same trafo). Just add it.
                     PrintObject *print_object = new PrintObject(this, model_object, new_instances.trafo, std::move(new_instances.instances));
                     print_object_apply_config(print_object);
+                    print_object_reuse_layers(print_object);
                     print_objects_new.emplace_back(print_object);
                     // print_object_status.emplace(PrintObjectStatus(print_object, PrintObjectStatus::New));
                     new_objects = true;
@@ -17,6 +17,7 @@
 #include "Model.hpp"
 #include "PlaceholderParser.hpp"
 #include "PrintConfig.hpp"
+#include "PrintProfiler.hpp"
 
 namespace Slic3r {
 
@@ -498,7 +499,8 @@ public:
     // Register a custom status callback.
     void                    set_status_callback(status_callback_type cb) { m_status_callback = cb; }
     // Calls a registered callback to update the status, or print out the default message.
-    void                    set_status(int percent, const std::string &message, unsigned int flags = SlicingStatus::DEFAULT) {
+    // Const, so that the status of exporting a const print could be reported as well.
+    void                    set_status(int percent, const std::string &message, unsigned int flags = SlicingStatus::DEFAULT) const {
 		if (m_status_callback) m_status_callback(SlicingStatus(percent, message, flags));
         else { printf("%d => %s\n", percent, message.c_str()); std::fflush(stdout); }
     }
@@ -536,6 +538,10 @@ public:
     // If filename_set is empty, than the path may be a file or directory. If it is a file, then the macro will not be processed.
     std::string                output_filepath(const std::string &path, const std::string &filename_base = std::string()) const;
 
+    // Wall time, CPU time and peak memory of the steps of process() and export_gcode(), disabled by default.
+    PrintProfiler&             profiler() { return m_profiler; }
+    const PrintProfiler&       profiler() const { return m_profiler; }
+
 protected:
 	friend class PrintObjectBase;
     friend class BackgroundSlicingProcess;
@@ -566,6 +572,8 @@ protected:
     // Callback to be evoked regularly to update state of the UI thread.
     status_callback_type                    m_status_callback;
 
+    PrintProfiler                           m_profiler;
+
 private:
     std::atomic<CancelStatus>               m_cancel_status;
 
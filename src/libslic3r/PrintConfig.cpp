@@ -6051,6 +6051,22 @@ CLIActionsConfigDef::CLIActionsConfigDef()
     def->cli = "gcodeviewer";
     def->set_default_value(new ConfigOptionBool(false));
 
+    // reads the jobs from the standard input
+
+    def = this->add("server", coBool);
+    def->label = L("Batch slicing server");
+    def->tooltip = L("Keep running and process the jobs read from the standard input, one job per line. "
+                     "A job is a JSON object with the command line arguments of a single run in the \"args\" array, for example "
+                     "{\"id\": \"1\", \"args\": [\"--export-gcode\", \"--load\", \"config.ini\", \"--output\", \"out.gcode\", \"model.stl\"]}. "
+                     "Instead of \"args\", the job may list the input files in \"input\", the output file in \"output\" "
+                     "and the configuration options in the \"config\" object, keyed by the option keys of the ini files (for example \"layer_height\"). "
+                     "The \"config\" options take precedence over the options in \"args\". A job without any action exports G-code "
+                     "or an SLA archive according to the printer technology. The configuration files loaded by --load of the server "
+                     "are loaded by all the jobs before their own ones and the data directory of the server is used by all the jobs. "
+                     "The result of each job is written to the standard output as a JSON line. The installed profiles are loaded once for all the jobs.");
+    def->cli = "server";
+    def->set_default_value(new ConfigOptionBool(false));
+
     // needs a configuration input
 
     def = this->add("save", coString);
@@ -6213,6 +6229,18 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->tooltip = L("Sets the maximum number of threads the slicing process will use. If not defined, it will be decided automatically.");
     def->min = 1;
 
+    def = this->add("server_jobs", coInt);
+    def->label = L("Number of concurrent server jobs");
+    def->tooltip = L("Maximum number of jobs processed concurrently in the --server mode. On Linux and macOS each job is processed "
+                     "by a separate worker process, thus the memory used by a finished job is returned to the system. "
+                     "On Windows the jobs are processed one after the other.");
+    def->min = 1;
+
+    def = this->add("profile_trace", coString);
+    def->label = L("Profile trace file");
+    def->tooltip = L("Measure the wall time, CPU time and peak memory of the slicing steps per print, per object and per layer "
+                     "and save them to the given file in the Chrome trace JSON format (chrome://tracing, ui.perfetto.dev).");
+
     def = this->add("loglevel", coInt);
     def->label = L("Logging level");
     def->tooltip = L("Sets logging sensitivity. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n"
@@ -18,6 +18,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <numeric>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -30,6 +31,7 @@
 #include <cstdlib>
 
 #include "AABBTreeLines.hpp"
+#include "Arachne/BeadingStrategy/BeadingStrategyFactory.hpp"
 #include "ExPolygon.hpp"
 #include "Flow.hpp"
 #include "libslic3r/GCode/ExtrusionProcessor.hpp"
@@ -178,6 +180,7 @@ void PrintObject::make_perimeters()
 
     if (! this->set_started(posPerimeters))
         return;
+    auto profile = this->profile_scope("object", "Perimeters");
 
     m_print->set_status(20, _u8L("Generating perimeters"));
     BOOST_LOG_TRIVIAL(info) << "Generating perimeters..." << log_memory_info();
@@ -199,85 +202,197 @@ void PrintObject::make_perimeters()
     // but we don't generate any extra perimeter if fill density is zero, as they would be floating
     // inside the object - infill_only_where_needed should be the method of choice for printing
     // hollow objects
+    auto detect_extra_perimeters = [](LayerRegion &layerm, const LayerRegion &upper_layerm) {
+        const PrintRegion &region               = layerm.region();
+        const Polygons upper_layerm_polygons    = to_polygons(upper_layerm.slices().surfaces);
+        // Filter upper layer polygons in intersection_ppl by their bounding boxes?
+        // my $upper_layerm_poly_bboxes= [ map $_->bounding_box, @{$upper_layerm_polygons} ];
+        const double total_loop_length      = total_length(upper_layerm_polygons);
+        const coord_t perimeter_spacing     = layerm.flow(frPerimeter).scaled_spacing();
+        const Flow ext_perimeter_flow       = layerm.flow(frExternalPerimeter);
+        const coord_t ext_perimeter_width   = ext_perimeter_flow.scaled_width();
+        const coord_t ext_perimeter_spacing = ext_perimeter_flow.scaled_spacing();
+
+        // slice is not const because slice.extra_perimeters is being incremented.
+        for (Surface &slice : layerm.m_slices.surfaces) {
+            for (;;) {
+                // compute the total thickness of perimeters
+                const coord_t perimeters_thickness = ext_perimeter_width/2 + ext_perimeter_spacing/2
+                    + (region.config().perimeters-1 + slice.extra_perimeters) * perimeter_spacing;
+                // define a critical area where we don't want the upper slice to fall into
+                // (it should either lay over our perimeters or outside this area)
+                const coord_t critical_area_depth = coord_t(perimeter_spacing * 1.5);
+                const Polygons critical_area = diff(
+                    offset(slice.expolygon, float(- perimeters_thickness)),
+                    offset(slice.expolygon, float(- perimeters_thickness - critical_area_depth))
+                );
+                // check whether a portion of the upper slices falls inside the critical area
+                const Polylines intersection = intersection_pl(to_polylines(upper_layerm_polygons), critical_area);
+                // only add an additional loop if at least 30% of the slice loop would benefit from it
+                if (total_length(intersection) <=  total_loop_length*0.3)
+                    break;
+                /*
+                if (0) {
+                    require "Slic3r/SVG.pm";
+                    Slic3r::SVG::output(
+                        "extra.svg",
+                        no_arrows   => 1,
+                        expolygons  => union_ex($critical_area),
+                        polylines   => [ map $_->split_at_first_point, map $_->p, @{$upper_layerm->slices} ],
+                    );
+                }
+                */
+                ++ slice.extra_perimeters;
+            }
+            #ifdef DEBUG
+                if (slice.extra_perimeters > 0)
+                    printf("  adding %d more perimeter(s) at layer %zu\n", slice.extra_perimeters, size_t(layerm.layer()->id()));
+            #endif
+        }
+    };
+    auto needs_extra_perimeters = [](const PrintRegion &region, size_t layer_count) {
+        return region.config().extra_perimeters && region.config().perimeters > 0 && region.config().fill_density > 0 && layer_count >= 2;
+    };
     for (size_t region_id = 0; region_id < this->num_printing_regions(); ++ region_id) {
-        const PrintRegion &region = this->printing_region(region_id);
-        if (! region.config().extra_perimeters || region.config().perimeters == 0 || region.config().fill_density == 0 || this->layer_count() < 2)
+        if (! needs_extra_perimeters(this->printing_region(region_id), this->layer_count()))
             continue;
 
         BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - start";
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, m_layers.size() - 1),
-            [this, &region, region_id](const tbb::blocked_range<size_t>& range) {
+            [this, region_id, &detect_extra_perimeters](const tbb::blocked_range<size_t>& range) {
                 PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
-                    LayerRegion &layerm                     = *m_layers[layer_idx]->get_region(region_id);
-                    const LayerRegion &upper_layerm         = *m_layers[layer_idx+1]->get_region(region_id);
-                    const Polygons upper_layerm_polygons    = to_polygons(upper_layerm.slices().surfaces);
-                    // Filter upper layer polygons in intersection_ppl by their bounding boxes?
-                    // my $upper_layerm_poly_bboxes= [ map $_->bounding_box, @{$upper_layerm_polygons} ];
-                    const double total_loop_length      = total_length(upper_layerm_polygons);
-                    const coord_t perimeter_spacing     = layerm.flow(frPerimeter).scaled_spacing();
-                    const Flow ext_perimeter_flow       = layerm.flow(frExternalPerimeter);
-                    const coord_t ext_perimeter_width   = ext_perimeter_flow.scaled_width();
-                    const coord_t ext_perimeter_spacing = ext_perimeter_flow.scaled_spacing();
-
-                    // slice is not const because slice.extra_perimeters is being incremented.
-                    for (Surface &slice : layerm.m_slices.surfaces) {
-                        for (;;) {
-                            // compute the total thickness of perimeters
-                            const coord_t perimeters_thickness = ext_perimeter_width/2 + ext_perimeter_spacing/2
-                                + (region.config().perimeters-1 + slice.extra_perimeters) * perimeter_spacing;
-                            // define a critical area where we don't want the upper slice to fall into
-                            // (it should either lay over our perimeters or outside this area)
-                            const coord_t critical_area_depth = coord_t(perimeter_spacing * 1.5);
-                            const Polygons critical_area = diff(
-                                offset(slice.expolygon, float(- perimeters_thickness)),
-                                offset(slice.expolygon, float(- perimeters_thickness - critical_area_depth))
-                            );
-                            // check whether a portion of the upper slices falls inside the critical area
-                            const Polylines intersection = intersection_pl(to_polylines(upper_layerm_polygons), critical_area);
-                            // only add an additional loop if at least 30% of the slice loop would benefit from it
-                            if (total_length(intersection) <=  total_loop_length*0.3)
-                                break;
-                            /*
-                            if (0) {
-                                require "Slic3r/SVG.pm";
-                                Slic3r::SVG::output(
-                                    "extra.svg",
-                                    no_arrows   => 1,
-                                    expolygons  => union_ex($critical_area),
-                                    polylines   => [ map $_->split_at_first_point, map $_->p, @{$upper_layerm->slices} ],
-                                );
-                            }
-                            */
-                            ++ slice.extra_perimeters;
-                        }
-                        #ifdef DEBUG
-                            if (slice.extra_perimeters > 0)
-                                printf("  adding %d more perimeter(s) at layer %zu\n", slice.extra_perimeters, layer_idx);
-                        #endif
-                    }
+                    detect_extra_perimeters(*m_layers[layer_idx]->get_region(region_id), *m_layers[layer_idx+1]->get_region(region_id));
                 }
             });
         m_print->throw_if_canceled();
         BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - end";
     }
 
+    // Layers of prismatic parts of an object often have exactly the same slices as the layer below them.
+    // Generate the perimeters just for the first layer of such a run and copy them to the other layers of the run.
+    // Fuzzy skin randomizes the perimeters of each layer and the spiral vase perimeters depend on the layer index, thus
+    // the perimeters are never reused with these features.
+    std::vector<size_t> perimeter_source_layer(m_layers.size());
+    std::iota(perimeter_source_layer.begin(), perimeter_source_layer.end(), 0);
+    bool reuse_perimeters = ! m_print->config().spiral_vase && ! this->is_fuzzy_skin_painted();
+    for (size_t region_id = 0; reuse_perimeters && region_id < this->num_printing_regions(); ++ region_id)
+        if (this->printing_region(region_id).config().fuzzy_skin != FuzzySkinType::None)
+            reuse_perimeters = false;
+    if (reuse_perimeters && m_layers.size() > 1) {
+        BOOST_LOG_TRIVIAL(debug) << "Detecting layers with identical perimeters in parallel - start";
+        std::vector<unsigned char> same_as_previous(m_layers.size(), false);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(1, m_layers.size()),
+            [this, &same_as_previous](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    same_as_previous[layer_idx] = m_layers[layer_idx]->has_same_perimeter_inputs(*m_layers[layer_idx - 1]);
+                }
+            });
+        m_print->throw_if_canceled();
+        for (size_t layer_idx = 1; layer_idx < m_layers.size(); ++ layer_idx)
+            if (same_as_previous[layer_idx])
+                perimeter_source_layer[layer_idx] = perimeter_source_layer[layer_idx - 1];
+        BOOST_LOG_TRIVIAL(debug) << "Detecting layers with identical perimeters in parallel - end";
+    }
+
+    // Only the modifiers of the ModelObject changed since the PrintObject this one replaced was processed.
+    // Copy the perimeters of the replaced PrintObject's layers outside of the Z range touched by the change,
+    // if the perimeter inputs are verified to be the same.
+    std::vector<const Layer*> reusable_source_layer;
+    if (! reuse_perimeters)
+        m_reusable_layers.reset();
+    else if (std::vector<Layer*> reusable = this->match_reusable_layers(); ! reusable.empty()) {
+        BOOST_LOG_TRIVIAL(debug) << "Detecting perimeters of the replaced object to reuse in parallel - start";
+        const LayerPtrs &reusable_layers = m_reusable_layers->layers;
+        if (m_reusable_layers->typed_slices) {
+            // The slices of the replaced object were split into top / internal / bottom surfaces, revert them to the state
+            // make_perimeters() generated the perimeters from.
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, reusable_layers.size()),
+                [this, &reusable_layers](const tbb::blocked_range<size_t>& range) {
+                    for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                        m_print->throw_if_canceled();
+                        reusable_layers[layer_idx]->restore_untyped_slices();
+                    }
+                });
+            m_reusable_layers->typed_slices = false;
+            for (size_t region_id = 0; region_id < reusable_layers.front()->region_count(); ++ region_id)
+                if (needs_extra_perimeters(reusable_layers.front()->get_region(region_id)->region(), reusable_layers.size()))
+                    tbb::parallel_for(tbb::blocked_range<size_t>(0, reusable_layers.size() - 1),
+                        [this, region_id, &reusable_layers, &detect_extra_perimeters](const tbb::blocked_range<size_t>& range) {
+                            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                                m_print->throw_if_canceled();
+                                detect_extra_perimeters(*reusable_layers[layer_idx]->get_region(region_id), *reusable_layers[layer_idx+1]->get_region(region_id));
+                            }
+                        });
+            m_print->throw_if_canceled();
+        }
+        reusable_source_layer.assign(m_layers.size(), nullptr);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, &reusable, &reusable_source_layer](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    if (reusable[layer_idx] && m_layers[layer_idx]->has_same_perimeter_inputs(*reusable[layer_idx]))
+                        reusable_source_layer[layer_idx] = reusable[layer_idx];
+                }
+            });
+        m_print->throw_if_canceled();
+        BOOST_LOG_TRIVIAL(debug) << "Detecting perimeters of the replaced object to reuse in parallel - end, " <<
+            std::count_if(reusable_source_layer.begin(), reusable_source_layer.end(), [](const Layer *l){ return l != nullptr; }) << " of " << m_layers.size() << " layers reused";
+    }
+
+    // Share the Arachne beading strategies and their memoized beadings between the layers of this object,
+    // release them when leaving this function.
+    Arachne::BeadingStrategyFactory::CacheScope beading_cache_scope;
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
     tbb::parallel_for(
         tbb::blocked_range<size_t>(0, m_layers.size()),
-        [this](const tbb::blocked_range<size_t>& range) {
+        [this, &perimeter_source_layer, &reusable_source_layer](const tbb::blocked_range<size_t>& range) {
             PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
-            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
-                m_print->throw_if_canceled();
-                m_layers[layer_idx]->make_perimeters();
-            }
+            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
+                if (! reusable_source_layer.empty() && reusable_source_layer[layer_idx] != nullptr) {
+                    m_print->throw_if_canceled();
+                    auto profile = this->profile_scope("layer", "Perimeters (reused)", int(layer_idx));
+                    m_layers[layer_idx]->copy_perimeters_from(*reusable_source_layer[layer_idx]);
+                } else if (perimeter_source_layer[layer_idx] == layer_idx) {
+                    m_print->throw_if_canceled();
+                    auto profile = this->profile_scope("layer", "Perimeters", int(layer_idx));
+                    m_layers[layer_idx]->make_perimeters();
+                }
         }
     );
     m_print->throw_if_canceled();
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
 
+    if (reuse_perimeters) {
+        BOOST_LOG_TRIVIAL(debug) << "Copying perimeters of identical layers in parallel - start";
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, &perimeter_source_layer, &reusable_source_layer](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
+                    if (size_t source_idx = perimeter_source_layer[layer_idx]; source_idx != layer_idx && 
+                        (reusable_source_layer.empty() || reusable_source_layer[layer_idx] == nullptr)) {
+                        m_print->throw_if_canceled();
+                        auto profile = this->profile_scope("layer", "Perimeters (copied)", int(layer_idx));
+                        m_layers[layer_idx]->copy_perimeters_from(*m_layers[source_idx]);
+                    }
+            });
+        m_print->throw_if_canceled();
+        BOOST_LOG_TRIVIAL(debug) << "Copying perimeters of identical layers in parallel - end";
+    }
+
+    if (m_reusable_layers) {
+        if (m_reusable_layers->fills_valid && std::any_of(reusable_source_layer.begin(), reusable_source_layer.end(), [](const Layer *l){ return l != nullptr; }))
+            // Keep just the layers, which may provide their infill.
+            m_reusable_layers->keep_perimeters_sources(std::move(reusable_source_layer));
+        else
+            m_reusable_layers.reset();
+    }
+
     this->set_done(posPerimeters);
 }
 
@@ -285,6 +400,7 @@ void PrintObject::prepare_infill()
 {
     if (! this->set_started(posPrepareInfill))
         return;
+    auto profile = this->profile_scope("object", "Prepare infill");
 
     m_print->set_status(30, _u8L("Preparing infill"));
 
@@ -445,24 +561,46 @@ void PrintObject::infill()
     this->prepare_infill();
 
     if (this->set_started(posInfill)) {
+        auto profile = this->profile_scope("object", "Infill");
         // TRN Status for the Print calculation 
         m_print->set_status(45, _u8L("Making infill"));
         const auto& adaptive_fill_octree = this->m_adaptive_fill_octrees.first;
         const auto& support_fill_octree = this->m_adaptive_fill_octrees.second;
 
+        // The layers, which perimeters were copied from the PrintObject this one replaced, may reuse its infill as well.
+        // Adaptive cubic, support cubic and lightning infills are generated for the object as a whole, thus they are never reused.
+        if (m_reusable_layers && (adaptive_fill_octree || support_fill_octree || m_lightning_generator ||
+            m_reusable_layers->perimeters_sources.size() != m_layers.size()))
+            m_reusable_layers.reset();
+        std::vector<const Layer*> *reusable_source_layer = m_reusable_layers ? &m_reusable_layers->perimeters_sources : nullptr;
+
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start";
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, m_layers.size()),
-            [this, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree](const tbb::blocked_range<size_t>& range) {
+            [this, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree, reusable_source_layer](const tbb::blocked_range<size_t>& range) {
                 PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
-                    m_layers[layer_idx]->make_fills(adaptive_fill_octree.get(), support_fill_octree.get(), this->m_lightning_generator.get());
+                    const Layer *source = reusable_source_layer ? (*reusable_source_layer)[layer_idx] : nullptr;
+                    if (source != nullptr && m_layers[layer_idx]->has_same_fill_inputs(*source)) {
+                        auto profile = this->profile_scope("layer", "Infill (reused)", int(layer_idx));
+                        m_layers[layer_idx]->copy_fills_from(*source);
+                    } else {
+                        auto profile = this->profile_scope("layer", "Infill", int(layer_idx));
+                        m_layers[layer_idx]->make_fills(adaptive_fill_octree.get(), support_fill_octree.get(), this->m_lightning_generator.get());
+                    }
+                    if (source != nullptr) {
+                        // Each layer of the replaced object is the source of a single layer, release it right away.
+                        delete source;
+                        (*reusable_source_layer)[layer_idx] = nullptr;
+                    }
                 }
             }
         );
         m_print->throw_if_canceled();
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end";
+        // Everything the layers of the replaced PrintObject could provide was taken.
+        m_reusable_layers.reset();
         /*  we could free memory now, but this would make this step not idempotent
         ### $_->fill_surfaces->clear for map @{$_->regions}, @{$object->layers};
         */
@@ -473,6 +611,7 @@ void PrintObject::infill()
 void PrintObject::ironing()
 {
     if (this->set_started(posIroning)) {
+        auto profile = this->profile_scope("object", "Ironing");
         BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - start";
         tbb::parallel_for(
             // Ironing starting with layer 0 to support ironing all surfaces.
@@ -494,6 +633,7 @@ void PrintObject::ironing()
 void PrintObject::generate_support_spots()
 {
     if (this->set_started(posSupportSpotsSearch)) {
+        auto profile = this->profile_scope("object", "Support spots search");
         BOOST_LOG_TRIVIAL(debug) << "Searching support spots - start";
         m_print->set_status(65, _u8L("Searching support spots"));
         if (!this->shared_regions()->generated_support_points.has_value()) {
@@ -518,6 +658,7 @@ void PrintObject::generate_support_spots()
 void PrintObject::generate_support_material()
 {
     if (this->set_started(posSupportMaterial)) {
+        auto profile = this->profile_scope("object", "Support material");
         this->clear_support_layers();
         if ((this->has_support() && m_layers.size() > 1) || (this->has_raft() && ! m_layers.empty())) {
             m_print->set_status(70, _u8L("Generating support material"));    
@@ -539,6 +680,7 @@ void PrintObject::generate_support_material()
 void PrintObject::estimate_curled_extrusions()
 {
     if (this->set_started(posEstimateCurledExtrusions)) {
+        auto profile = this->profile_scope("object", "Estimate curled extrusions");
         if (this->print()->config().avoid_crossing_curled_overhangs ||
             std::any_of(this->print()->m_print_regions.begin(), this->print()->m_print_regions.end(),
                         [](const PrintRegion *region) { return region->config().enable_dynamic_overhang_speeds.getBool(); })) {
@@ -563,6 +705,7 @@ void PrintObject::estimate_curled_extrusions()
 void PrintObject::calculate_overhanging_perimeters()
 {
     if (this->set_started(posCalculateOverhangingPerimeters)) {
+        auto profile = this->profile_scope("object", "Calculate overhanging perimeters");
         BOOST_LOG_TRIVIAL(debug) << "Calculating overhanging perimeters - start";
         m_print->set_status(89, _u8L("Calculating overhanging perimeters"));
         std::vector<unsigned int>               extruders;
@@ -619,6 +762,11 @@ void PrintObject::calculate_overhanging_perimeters()
     }
 }
 
+PrintProfiler::Scope PrintObject::profile_scope(const char *category, const char *name, int layer_id)
+{
+    return PrintProfiler::Scope(m_print->profiler(), category, name, int(this->id().id), layer_id);
+}
+
 std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> PrintObject::prepare_adaptive_infill_data(
     const std::vector<std::pair<const Surface *, float>> &surfaces_w_bottom_z) const
 {
@@ -682,6 +830,94 @@ void PrintObject::clear_layers()
     m_layers.clear();
 }
 
+PrintObject::ReusableLayers::~ReusableLayers()
+{
+    for (Layer *l : layers)
+        delete l;
+    for (const Layer *l : perimeters_sources)
+        delete l;
+}
+
+void PrintObject::ReusableLayers::keep_perimeters_sources(std::vector<const Layer*> &&sources)
+{
+    std::vector<const Layer*> sorted;
+    sorted.reserve(sources.size());
+    for (const Layer *l : sources)
+        if (l != nullptr)
+            sorted.emplace_back(l);
+    std::sort(sorted.begin(), sorted.end());
+    assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+    for (Layer *l : layers)
+        if (std::binary_search(sorted.begin(), sorted.end(), l)) {
+            // Their neighbors may be released, the fill inputs do not depend on them.
+            l->upper_layer = nullptr;
+            l->lower_layer = nullptr;
+        } else
+            delete l;
+    layers.clear();
+    perimeters_sources = std::move(sources);
+}
+
+std::unique_ptr<PrintObject::ReusableLayers> PrintObject::release_reusable_layers(
+    std::shared_ptr<std::vector<std::unique_ptr<PrintRegion>>> regions, const t_layer_height_range &dirty_z_range)
+{
+    if (m_layers.empty() || ! this->is_step_done(posPerimeters))
+        return {};
+    auto out = std::make_unique<ReusableLayers>();
+    out->layers        = std::move(m_layers);
+    m_layers.clear();
+    out->regions       = std::move(regions);
+    out->config        = m_config;
+    out->dirty_z_range = dirty_z_range;
+    out->typed_slices  = m_typed_slices;
+    out->fills_valid   = this->is_step_done(posInfill);
+    return out;
+}
+
+void PrintObject::set_reusable_layers(std::unique_ptr<ReusableLayers> &&reusable_layers)
+{
+    m_reusable_layers = std::move(reusable_layers);
+    // The layers query their PrintObject for its configuration, the replaced PrintObject is going to be deleted.
+    if (m_reusable_layers)
+        for (Layer *layer : m_reusable_layers->layers)
+            layer->m_object = this;
+}
+
+std::vector<Layer*> PrintObject::match_reusable_layers()
+{
+    std::vector<Layer*> out;
+    if (! m_reusable_layers)
+        return out;
+    if (m_reusable_layers->layers.empty() || ! (m_reusable_layers->config == m_config)) {
+        // Configuration of the object changed, nothing could be reused.
+        m_reusable_layers.reset();
+        return out;
+    }
+
+    // Slices of the layers overlapping the Z range touched by the change are different,
+    // perimeters of the layers next to them are influenced by them, too.
+    const t_layer_height_range &dirty_z_range = m_reusable_layers->dirty_z_range;
+    std::vector<unsigned char>  dirty(m_layers.size(), false);
+    for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
+        const Layer &layer = *m_layers[layer_idx];
+        dirty[layer_idx] = layer.print_z > dirty_z_range.first - EPSILON && layer.print_z - layer.height < dirty_z_range.second + EPSILON;
+    }
+
+    out.assign(m_layers.size(), nullptr);
+    const LayerPtrs &reusable    = m_reusable_layers->layers;
+    auto             it_reusable = reusable.begin();
+    for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
+        if (dirty[layer_idx] || (layer_idx > 0 && dirty[layer_idx - 1]) || (layer_idx + 1 < m_layers.size() && dirty[layer_idx + 1]))
+            continue;
+        const Layer &layer = *m_layers[layer_idx];
+        it_reusable = std::lower_bound(it_reusable, reusable.end(), layer.print_z - EPSILON, [](const Layer *l, coordf_t z) { return l->print_z < z; });
+        if (it_reusable != reusable.end() && std::abs((*it_reusable)->print_z - layer.print_z) < EPSILON &&
+            (*it_reusable)->height == layer.height && (*it_reusable)->id() == layer.id())
+            out[layer_idx] = *it_reusable;
+    }
+    return out;
+}
+
 Layer* PrintObject::add_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z)
 {
     m_layers.emplace_back(new Layer(id, this, height, print_z, slice_z));
@@ -1705,17 +1941,45 @@ void PrintObject::discover_vertical_shells()
                         //      the in-model condition is there due to small sloping surfaces, e.g. top of the hull of the benchy
                         //   2. the area does not fully cover an internal polygon
                         //         This is there mainly for a very thin parts, where the solid layers would be missing if the part area is quite small
-                        regularized_shell.erase(std::remove_if(regularized_shell.begin(), regularized_shell.end(),
-                                                               [&internal_volume, &min_perimeter_infill_spacing,
-                                                                &object_volume](const ExPolygon &p) {
-                                                                   return (p.area() < min_perimeter_infill_spacing * scaled(1.5) ||
-                                                                           (p.area() < min_perimeter_infill_spacing * scaled(8.0) &&
-                                                                            diff(to_polygons(p), object_volume).empty())) &&
-                                                                          diff(internal_volume,
-                                                                               expand(to_polygons(p), min_perimeter_infill_spacing))
-                                                                                  .size() >= internal_volume.size();
-                                                               }),
-                                                regularized_shell.end());
+                        // There may be many tiny regions, thus the boolean operations of all the regions are batched.
+                        std::vector<unsigned char> to_remove(regularized_shell.size(), false);
+                        {
+                            ClipperBatch        batch;
+                            std::vector<size_t> batch_idx(regularized_shell.size(), size_t(-1));
+                            for (size_t i = 0; i < regularized_shell.size(); ++ i) {
+                                const double area = regularized_shell[i].area();
+                                if (area < min_perimeter_infill_spacing * scaled(1.5))
+                                    to_remove[i] = true;
+                                else if (area < min_perimeter_infill_spacing * scaled(8.0))
+                                    batch_idx[i] = batch.add(ClipperLib::ctDifference, regularized_shell[i], object_volume);
+                            }
+                            std::vector<Polygons> outside_object_volume = batch.execute();
+                            for (size_t i = 0; i < regularized_shell.size(); ++ i)
+                                if (batch_idx[i] != size_t(-1))
+                                    to_remove[i] = outside_object_volume[batch_idx[i]].empty();
+                        }
+                        {
+                            ClipperBatch          batch;
+                            std::vector<Polygons> expanded(regularized_shell.size());
+                            std::vector<size_t>   batch_idx(regularized_shell.size(), size_t(-1));
+                            for (size_t i = 0; i < regularized_shell.size(); ++ i)
+                                if (to_remove[i]) {
+                                    expanded[i]  = expand(to_polygons(regularized_shell[i]), min_perimeter_infill_spacing);
+                                    batch_idx[i] = batch.add(ClipperLib::ctDifference, internal_volume, expanded[i]);
+                                }
+                            std::vector<Polygons> not_covered = batch.execute();
+                            for (size_t i = 0; i < regularized_shell.size(); ++ i)
+                                if (to_remove[i])
+                                    to_remove[i] = not_covered[batch_idx[i]].size() >= internal_volume.size();
+                        }
+                        size_t num_kept = 0;
+                        for (size_t i = 0; i < regularized_shell.size(); ++ i)
+                            if (! to_remove[i]) {
+                                if (num_kept < i)
+                                    regularized_shell[num_kept] = std::move(regularized_shell[i]);
+                                ++ num_kept;
+                            }
+                        regularized_shell.erase(regularized_shell.begin() + num_kept, regularized_shell.end());
                     }
                     if (regularized_shell.empty())
                         continue;
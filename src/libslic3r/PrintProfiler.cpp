@@ -0,0 +1,161 @@
+#include "PrintProfiler.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#include <boost/nowide/fstream.hpp>
+
+#include "Exception.hpp"
+#include "Utils.hpp"
+#include "format.hpp"
+
+namespace Slic3r {
+
+// Index of the calling thread, assigned on the first use.
+static int profiler_thread_idx()
+{
+    static std::atomic<int> s_next_thread_idx { 0 };
+    thread_local int        thread_idx = s_next_thread_idx.fetch_add(1, std::memory_order_relaxed);
+    return thread_idx;
+}
+
+PrintProfiler::Scope::Scope(PrintProfiler &profiler, const char *category, std::string name, int object_id, int layer_id) :
+    m_profiler(profiler.enabled() ? &profiler : nullptr)
+{
+    if (m_profiler) {
+        m_event.name        = std::move(name);
+        m_event.category    = category;
+        m_event.object_id   = object_id;
+        m_event.layer_id    = layer_id;
+        m_event.thread_idx  = profiler_thread_idx();
+        m_event.peak_memory = peak_memory_usage();
+        m_cpu_begin_us      = thread_cpu_time_us();
+        m_event.begin_us    = m_profiler->now_us();
+    }
+}
+
+PrintProfiler::Scope::~Scope()
+{
+    if (m_profiler) {
+        m_event.duration_us = m_profiler->now_us() - m_event.begin_us;
+        m_event.cpu_us      = thread_cpu_time_us() - m_cpu_begin_us;
+        const size_t peak   = peak_memory_usage();
+        m_event.peak_memory_growth = peak > m_event.peak_memory ? peak - m_event.peak_memory : 0;
+        m_event.peak_memory = peak;
+        m_profiler->add_event(std::move(m_event));
+    }
+}
+
+void PrintProfiler::enable(bool enable)
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    if (enable)
+        m_start = std::chrono::steady_clock::now();
+    m_enabled.store(enable, std::memory_order_relaxed);
+}
+
+void PrintProfiler::clear()
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+void PrintProfiler::add_event(Event &&event)
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_events.emplace_back(std::move(event));
+}
+
+std::vector<PrintProfiler::Event> PrintProfiler::events() const
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    return m_events;
+}
+
+int64_t PrintProfiler::now_us() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+int64_t PrintProfiler::thread_cpu_time_us()
+{
+#ifdef _WIN32
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (! GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+        return 0;
+    // FILETIME is in 100ns units.
+    auto to_us = [](const FILETIME &t) { return int64_t((uint64_t(t.dwHighDateTime) << 32) | t.dwLowDateTime) / 10; };
+    return to_us(kernel_time) + to_us(user_time);
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return int64_t(ts.tv_sec) * 1000000 + int64_t(ts.tv_nsec) / 1000;
+#endif
+}
+
+static std::string json_escape(const std::string &str)
+{
+    std::string out;
+    out.reserve(str.size());
+    for (const char c : str) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n";  break;
+        case '\t': out += "\\t";  break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                char buf[8];
+                sprintf(buf, "\\u%04x", int(c));
+                out += buf;
+            } else
+                out += c;
+        }
+    }
+    return out;
+}
+
+std::string PrintProfiler::chrome_trace() const
+{
+    std::vector<Event> events = this->events();
+    std::sort(events.begin(), events.end(), [](const Event &l, const Event &r) { return l.begin_us < r.begin_us; });
+
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool        first = true;
+    for (const Event &event : events) {
+        if (! first)
+            out += ",";
+        first = false;
+        // Complete events ("ph":"X") carry both the start and the duration.
+        out += format("\n{\"name\":\"%1%\",\"cat\":\"%2%\",\"ph\":\"X\",\"pid\":1,\"tid\":%3%,\"ts\":%4%,\"dur\":%5%,\"args\":{\"cpu_us\":%6%,\"peak_memory\":%7%,\"peak_memory_growth\":%8%",
+            json_escape(event.name), event.category, event.thread_idx, event.begin_us, event.duration_us, event.cpu_us, event.peak_memory, event.peak_memory_growth);
+        if (event.object_id != -1)
+            out += format(",\"object_id\":%1%", event.object_id);
+        if (event.layer_id != -1)
+            out += format(",\"layer_id\":%1%", event.layer_id);
+        out += "}}";
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+void PrintProfiler::export_chrome_trace(const std::string &path) const
+{
+    boost::nowide::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (! file.good())
+        throw Slic3r::FileIOError(format("Failed to open the profile trace file %1% for writing.", path));
+    file << this->chrome_trace();
+    file.close();
+    if (file.fail())
+        throw Slic3r::FileIOError(format("Failed to write the profile trace file %1%.", path));
+}
+
+} // namespace Slic3r
@@ -0,0 +1,87 @@
+#ifndef slic3r_PrintProfiler_hpp_
+#define slic3r_PrintProfiler_hpp_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Slic3r {
+
+// Collects the wall time, CPU time and peak memory of the steps of the slicing pipeline
+// (per Print step, per PrintObject step and per layer) for the Chrome trace event format,
+// to be viewed by chrome://tracing or https://ui.perfetto.dev
+// Profiling is disabled by default, a disabled profiler does not record anything
+// and a PrintProfiler::Scope over a disabled profiler does not even read the clock.
+class PrintProfiler
+{
+public:
+    struct Event {
+        std::string     name;
+        // "print", "object", "layer" or other category of the event.
+        const char     *category    { "" };
+        // Start of the event in microseconds since the profiler was enabled.
+        int64_t         begin_us    { 0 };
+        int64_t         duration_us { 0 };
+        // CPU time of the thread executing the event.
+        int64_t         cpu_us      { 0 };
+        // Peak resident memory of the process in bytes at the end of the event.
+        size_t          peak_memory { 0 };
+        // Growth of the peak resident memory of the process during the event.
+        size_t          peak_memory_growth { 0 };
+        // Index of the thread executing the event, the indices are assigned in the order the threads appear.
+        int             thread_idx  { 0 };
+        // Identifier of the PrintObject and index of the layer, -1 if not applicable.
+        int             object_id   { -1 };
+        int             layer_id    { -1 };
+    };
+
+    // RAII measurement of a single event, recorded into the profiler when the scope ends.
+    class Scope
+    {
+    public:
+        Scope(PrintProfiler &profiler, const char *category, std::string name, int object_id = -1, int layer_id = -1);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        // nullptr if the profiler was disabled when the scope was started.
+        PrintProfiler  *m_profiler;
+        Event           m_event;
+        int64_t         m_cpu_begin_us { 0 };
+    };
+
+    PrintProfiler() = default;
+
+    // Enabling the profiler resets the time origin of the events, recorded events are kept.
+    void                enable(bool enable);
+    bool                enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void                clear();
+
+    void                add_event(Event &&event);
+    std::vector<Event>  events() const;
+
+    // Microseconds since the profiler was enabled.
+    int64_t             now_us() const;
+
+    // Export the recorded events as Chrome trace JSON, throws Slic3r::FileIOError if the file could not be written.
+    void                export_chrome_trace(const std::string &path) const;
+    std::string         chrome_trace() const;
+
+    // CPU time consumed by the calling thread in microseconds.
+    static int64_t      thread_cpu_time_us();
+
+private:
+    std::atomic<bool>                       m_enabled { false };
+    std::chrono::steady_clock::time_point   m_start { std::chrono::steady_clock::now() };
+    mutable std::mutex                      m_mutex;
+    std::vector<Event>                      m_events;
+};
+
+} // namespace Slic3r
+
+#endif /* slic3r_PrintProfiler_hpp_ */
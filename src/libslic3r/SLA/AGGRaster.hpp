@@ -35,33 +35,14 @@ template<class Color> struct Colors {
 template<class Color> const Color Colors<Color>::White = Color{255};
 template<class Color> const Color Colors<Color>::Black = Color{0};
 
-template<class PixelRenderer,
-         template<class /*agg::renderer_base<PixelRenderer>*/> class Renderer,
-         class Rasterizer = agg::rasterizer_scanline_aa<>,
-         class Scanline   = agg::scanline_p8>
-class AGGRaster: public RasterBase {
-public:
-    using TColor = typename PixelRenderer::color_type;
-    using TValue = typename TColor::value_type;
-    using TPixel = typename PixelRenderer::pixel_type;
-    using TRawBuffer = agg::rendering_buffer;
-
+// Common part of the AGG rasters: transformation of the polygons into AGG paths
+// in the pixel coordinates of the raster.
+class AGGRasterBase: public RasterBase {
 protected:
     
     Resolution m_resolution;
     PixelDim m_pxdim_scaled;    // used for scaled coordinate polygons
-    
-    std::vector<TPixel> m_buf;
-    agg::rendering_buffer m_rbuf;
-    
-    PixelRenderer m_pixrenderer;
-    
-    agg::renderer_base<PixelRenderer> m_raw_renderer;
-    Renderer<agg::renderer_base<PixelRenderer>> m_renderer;
-    
     Trafo m_trafo;
-    Scanline m_scanlines;
-    Rasterizer m_rasterizer;
     
     void flipy(agg::path_storage &path) const
     {
@@ -114,12 +95,64 @@ protected:
         return path;
     }
     
-    template<class P> void _draw(const P &poly)
+    template<class Rasterizer, class P> void add_paths(Rasterizer &rasterizer, const P &poly)
     {
-        m_rasterizer.reset();
+        rasterizer.reset();
         
-        m_rasterizer.add_path(to_path(contour(poly)));
-        for(auto& h : holes(poly)) m_rasterizer.add_path(to_path(h));
+        rasterizer.add_path(to_path(contour(poly)));
+        for(auto& h : holes(poly)) rasterizer.add_path(to_path(h));
+    }
+    
+    AGGRasterBase(const Resolution &res, const PixelDim &pd, const Trafo &trafo)
+        : m_resolution(res)
+        , m_pxdim_scaled(SCALING_FACTOR, SCALING_FACTOR)
+        , m_trafo(trafo)
+    {
+        // Visual Studio compiler gives warnings about possible division by zero.
+        assert(pd.w_mm != 0 && pd.h_mm != 0);
+        if (pd.w_mm != 0 && pd.h_mm != 0) {
+            m_pxdim_scaled.w_mm /= pd.w_mm;
+            m_pxdim_scaled.h_mm /= pd.h_mm;
+        }
+    }
+    
+public:
+    Trafo trafo() const override { return m_trafo; }
+    Resolution resolution() const { return m_resolution; }
+    PixelDim   pixel_dimensions() const
+    {
+        return {SCALING_FACTOR / m_pxdim_scaled.w_mm,
+                SCALING_FACTOR / m_pxdim_scaled.h_mm};
+    }
+};
+
+template<class PixelRenderer,
+         template<class /*agg::renderer_base<PixelRenderer>*/> class Renderer,
+         class Rasterizer = agg::rasterizer_scanline_aa<>,
+         class Scanline   = agg::scanline_p8>
+class AGGRaster: public AGGRasterBase {
+public:
+    using TColor = typename PixelRenderer::color_type;
+    using TValue = typename TColor::value_type;
+    using TPixel = typename PixelRenderer::pixel_type;
+    using TRawBuffer = agg::rendering_buffer;
+
+protected:
+    
+    std::vector<TPixel> m_buf;
+    agg::rendering_buffer m_rbuf;
+    
+    PixelRenderer m_pixrenderer;
+    
+    agg::renderer_base<PixelRenderer> m_raw_renderer;
+    Renderer<agg::renderer_base<PixelRenderer>> m_renderer;
+    
+    Scanline m_scanlines;
+    Rasterizer m_rasterizer;
+    
+    template<class P> void _draw(const P &poly)
+    {
+        add_paths(m_rasterizer, poly);
         
         agg::render_scanlines(m_rasterizer, m_scanlines, m_renderer);
     }
@@ -132,8 +165,7 @@ public:
               const TColor &    foreground,
               const TColor &    background,
               GammaFn &&        gammafn)
-        : m_resolution(res)
-        , m_pxdim_scaled(SCALING_FACTOR, SCALING_FACTOR)
+        : AGGRasterBase(res, pd, trafo)
         , m_buf(res.pixels())
         , m_rbuf(reinterpret_cast<TValue *>(m_buf.data()),
                  unsigned(res.width_px),
@@ -142,28 +174,13 @@ public:
         , m_pixrenderer(m_rbuf)
         , m_raw_renderer(m_pixrenderer)
         , m_renderer(m_raw_renderer)
-        , m_trafo(trafo)
     {
-        // Visual Studio compiler gives warnings about possible division by zero.
-        assert(pd.w_mm != 0 && pd.h_mm != 0);
-        if (pd.w_mm != 0 && pd.h_mm != 0) {
-            m_pxdim_scaled.w_mm /= pd.w_mm;
-            m_pxdim_scaled.h_mm /= pd.h_mm;
-        }
         m_renderer.color(foreground);
         clear(background);
         
         m_rasterizer.gamma(gammafn);
     }
     
-    Trafo trafo() const override { return m_trafo; }
-    Resolution resolution() const { return m_resolution; }
-    PixelDim   pixel_dimensions() const
-    {
-        return {SCALING_FACTOR / m_pxdim_scaled.w_mm,
-                SCALING_FACTOR / m_pxdim_scaled.h_mm};
-    }
-    
     void draw(const ExPolygon &poly) override { _draw(poly); }
     
     EncodedRaster encode(RasterEncoder encoder) const override
@@ -224,6 +241,60 @@ public:
     {}
 };
 
+/*
+ * Anti-aliased monochrome canvas with the same output as RasterGrayscaleAA,
+ * which does not allocate the bitmap. Each row is stored as a list of runs of
+ * pixels of the same value produced directly by the scanline rasterizer,
+ * thus the memory is proportional to the length of the contours, not to the
+ * area of the raster. Rows are expanded one by one when encoding.
+ */
+class RasterGrayscaleAARunLength : public AGGRasterBase {
+public:
+    // Pixels [x, x + len) of a row having the same nonzero value.
+    struct Run {
+        uint32_t x;
+        uint32_t len;
+        uint8_t  value;
+    };
+    
+private:
+    std::vector<std::vector<Run>> m_rows;
+    
+    agg::scanline_p8 m_scanlines;
+    agg::rasterizer_scanline_aa<> m_rasterizer;
+    
+    // Reused by draw() to avoid reallocation.
+    std::vector<Run> m_covers;
+    std::vector<Run> m_merged;
+    
+public:
+    template<class GammaFn>
+    RasterGrayscaleAARunLength(const Resolution        &res,
+                               const PixelDim          &pd,
+                               const RasterBase::Trafo &trafo,
+                               GammaFn                &&fn)
+        : AGGRasterBase(res, pd, trafo)
+        , m_rows(res.height_px)
+    {
+        m_rasterizer.gamma(std::forward<GammaFn>(fn));
+        m_rasterizer.clip_box(0., 0., double(res.width_px), double(res.height_px));
+    }
+    
+    void draw(const ExPolygon &poly) override;
+    
+    // PNG is encoded from the runs row by row, other encoders receive the expanded bitmap.
+    EncodedRaster encode(RasterEncoder encoder) const override;
+    
+    const std::vector<Run>& row_runs(size_t row) const { return m_rows[row]; }
+    
+    // Expand a row into width_px pixels.
+    void read_row(size_t row, uint8_t *out) const;
+    
+    uint8_t read_pixel(size_t col, size_t row) const;
+    
+    void clear() { for (std::vector<Run> &row : m_rows) row.clear(); }
+};
+
 }} // namespace Slic3r::sla
 
 #endif // AGGRASTER_HPP
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <set>
 #include <string>
 #include <cassert>
@@ -282,16 +283,24 @@ bool DefaultSupportTree::interconnect(const Pillar &pillar,
 bool DefaultSupportTree::connect_to_nearpillar(const Head &head,
                                                   long        nearpillar_id)
 {
-    auto nearpillar = [this, nearpillar_id]() -> const Pillar& {
-        return m_builder.pillar(nearpillar_id);
-    };
+    // A copy, the builder may grow meanwhile in another thread
+    Pillar nearpillar = m_builder.pillar(nearpillar_id);
 
-    if (m_builder.bridgecount(nearpillar()) > m_sm.cfg.max_bridges_on_pillar)
+    if (m_builder.bridgecount(nearpillar) > m_sm.cfg.max_bridges_on_pillar)
         return false;
 
+    auto br = search_nearpillar_bridge(head, nearpillar);
+
+    return br && add_nearpillar_bridge(head, nearpillar_id, *br);
+}
+
+std::optional<DefaultSupportTree::NearPillarBridge>
+DefaultSupportTree::search_nearpillar_bridge(const Head   &head,
+                                             const Pillar &nearpillar)
+{
     Vec3d headjp = head.junction_point();
-    Vec3d nearjp_u = nearpillar().startpoint();
-    Vec3d nearjp_l = nearpillar().endpoint();
+    Vec3d nearjp_u = nearpillar.startpoint();
+    Vec3d nearjp_l = nearpillar.endpoint();
 
     double r = head.r_back_mm;
     double d2d = distance(to_2d(headjp), to_2d(nearjp_u));
@@ -325,39 +334,49 @@ bool DefaultSupportTree::connect_to_nearpillar(const Head &head,
 
                // We can't insert a pillar under the source head to connect
                // with the nearby pillar's starting junction
-            if(t < zdiff) return false;
+            if(t < zdiff) return {};
         }
 
         if(Zdown <= nearjp_u.z() && Zdown >= nearjp_l.z() && D < max_len)
             bridgeend.z() = Zdown;
         else
-            return false;
+            return {};
     }
 
        // There will be a minimum distance from the ground where the
        // bridge is allowed to connect. This is an empiric value.
     double minz = ground_level(m_sm) + 4 * head.r_back_mm;
-    if(bridgeend.z() < minz) return false;
+    if(bridgeend.z() < minz) return {};
 
     double t = bridge_mesh_distance(bridgestart, dirv(bridgestart, bridgeend), r);
 
        // Cannot insert the bridge. (further search might not worth the hassle)
-    if(t < distance(bridgestart, bridgeend)) return false;
+    if(t < distance(bridgestart, bridgeend)) return {};
 
+    return NearPillarBridge{bridgestart, bridgeend, zdiff > 0};
+}
+
+bool DefaultSupportTree::add_nearpillar_bridge(const Head             &head,
+                                               long                    nearpillar_id,
+                                               const NearPillarBridge &br)
+{
     std::lock_guard lk(m_bridge_mutex);
 
-    if (m_builder.bridgecount(nearpillar()) < m_sm.cfg.max_bridges_on_pillar) {
-        // A partial pillar is needed under the starting head.
-        if(zdiff > 0) {
-            m_builder.add_pillar(head.id, headjp.z() - bridgestart.z());
-            m_builder.add_junction(bridgestart, r);
-            m_builder.add_bridge(bridgestart, bridgeend, r);
-        } else {
-            m_builder.add_bridge(head.id, bridgeend);
-        }
+    if (m_builder.bridgecount(m_builder.pillar(nearpillar_id)) >=
+        m_sm.cfg.max_bridges_on_pillar)
+        return false;
 
-        m_builder.increment_bridges(nearpillar());
-    } else return false;
+    // A partial pillar is needed under the starting head.
+    if (br.partial_pillar) {
+        double r = head.r_back_mm;
+        m_builder.add_pillar(head.id, head.junction_point().z() - br.startp.z());
+        m_builder.add_junction(br.startp, r);
+        m_builder.add_bridge(br.startp, br.endp, r);
+    } else {
+        m_builder.add_bridge(head.id, br.endp);
+    }
+
+    m_builder.increment_bridges(m_builder.pillar(nearpillar_id));
 
     return true;
 }
@@ -366,14 +385,20 @@ bool DefaultSupportTree::create_ground_pillar(const Junction &hjp,
                                              const Vec3d &sourcedir,
                                              long         head_id)
 {
-    auto [ret, pillar_id] = sla::create_ground_pillar(suptree_ex_policy,
-                                                      m_builder,
-                                                      m_sm,
-                                                      hjp.pos,
-                                                      sourcedir,
-                                                      hjp.r,
-                                                      hjp.r,
-                                                      head_id);
+    return add_ground_pillar(sla::search_ground_pillar(suptree_ex_policy,
+                                                       m_sm,
+                                                       hjp.pos,
+                                                       sourcedir,
+                                                       hjp.r,
+                                                       hjp.r),
+                             head_id);
+}
+
+bool DefaultSupportTree::add_ground_pillar(const GroundPillarRoute &route,
+                                           long                     head_id)
+{
+    auto [ret, pillar_id] = sla::add_ground_pillar(m_builder, m_sm, route,
+                                                   head_id);
 
     if (pillar_id >= 0) // Save the pillar endpoint in the spatial index
         m_pillar_index.guarded_insert(m_builder.pillar(pillar_id).endpt,
@@ -576,72 +601,121 @@ void DefaultSupportTree::classify()
 
 void DefaultSupportTree::routing_to_ground()
 {
-    ClusterEl cl_centroids;
-    cl_centroids.reserve(m_pillar_clusters.size());
+    // The clusters are independent groups of ground facing heads, so the
+    // routes are searched concurrently for all of them. The found elements
+    // are added to the builder in cluster order afterwards. This keeps the
+    // element ids and the bridge counts of the pillars, and so the whole
+    // result, independent of the thread scheduling.
+    constexpr unsigned NO_CENTROID = std::numeric_limits<unsigned>::max();
 
-    for (auto &cl : m_pillar_clusters) {
-        m_thr();
+    ClusterEl cl_centroids(m_pillar_clusters.size(), NO_CENTROID);
+    std::vector<GroundPillarRoute> cl_routes(m_pillar_clusters.size());
+
+    execution::for_each(
+        suptree_ex_policy, size_t(0), m_pillar_clusters.size(),
+        [this, &cl_centroids, &cl_routes](size_t ci) {
+            m_thr();
+
+            // place all the centroid head positions into the index. We
+            // will query for alternative pillar positions. If a sidehead
+            // cannot connect to the cluster centroid, we have to search
+            // for another head with a full pillar. Also when there are two
+            // elements in the cluster, the centroid is arbitrary and the
+            // sidehead is allowed to connect to a nearby pillar to
+            // increase structural stability.
 
-        // place all the centroid head positions into the index. We
-        // will query for alternative pillar positions. If a sidehead
-        // cannot connect to the cluster centroid, we have to search
-        // for another head with a full pillar. Also when there are two
-        // elements in the cluster, the centroid is arbitrary and the
-        // sidehead is allowed to connect to a nearby pillar to
-        // increase structural stability.
+            const PtIndices &cl = m_pillar_clusters[ci];
+            if (cl.empty()) return;
 
-        if (cl.empty()) continue;
+            // get the current cluster centroid
+            auto &      thr    = m_thr;
+            const auto &points = m_points;
 
-           // get the current cluster centroid
-        auto &      thr    = m_thr;
-        const auto &points = m_points;
+            long lcid = cluster_centroid(
+                cl, [&points](size_t idx) { return points.row(long(idx)); },
+                [thr](const Vec3d &p1, const Vec3d &p2) {
+                    thr();
+                    return distance(Vec2d(p1.x(), p1.y()), Vec2d(p2.x(), p2.y()));
+                });
 
-        long lcid = cluster_centroid(
-            cl, [&points](size_t idx) { return points.row(long(idx)); },
-            [thr](const Vec3d &p1, const Vec3d &p2) {
-                thr();
-                return distance(Vec2d(p1.x(), p1.y()), Vec2d(p2.x(), p2.y()));
-            });
+            assert(lcid >= 0);
+            unsigned hid = cl[size_t(lcid)]; // Head ID
 
-        assert(lcid >= 0);
-        unsigned hid = cl[size_t(lcid)]; // Head ID
+            cl_centroids[ci] = hid;
 
-        cl_centroids.emplace_back(hid);
+            Junction hjp = m_builder.head(hid).junction();
+            cl_routes[ci] = sla::search_ground_pillar(suptree_ex_policy, m_sm,
+                                                      hjp.pos,
+                                                      m_builder.head(hid).dir,
+                                                      hjp.r, hjp.r);
+        },
+        execution::max_concurrency(suptree_ex_policy));
 
-        Head &h = m_builder.head(hid);
+    for (size_t ci = 0; ci < m_pillar_clusters.size(); ++ci) {
+        unsigned hid = cl_centroids[ci];
+        if (hid == NO_CENTROID) continue;
 
-        if (!create_ground_pillar(h.junction(), h.dir, h.id)) {
+        if (!add_ground_pillar(cl_routes[ci], hid)) {
             BOOST_LOG_TRIVIAL(warning)
                 << "Pillar cannot be created for support point id: " << hid;
-            m_iheads_onmodel.emplace_back(h.id);
-            continue;
+            m_iheads_onmodel.emplace_back(hid);
         }
     }
 
     // now we will go through the clusters ones again and connect the
     // sidepoints with the cluster centroid (which is a ground pillar)
-    // or a nearby pillar if the centroid is unreachable.
-    size_t ci = 0;
-    for (const std::vector<unsigned> &cl : m_pillar_clusters) {
-        m_thr();
+    // or a nearby pillar if the centroid is unreachable. Only the bridges
+    // to the centroid pillars are searched concurrently, a pillar takes
+    // a limited number of bridges in the order they are added.
+    std::vector<long> cl_pillars(m_pillar_clusters.size(),
+                                 SupportTreeNode::ID_UNSET);
+    std::vector<std::vector<std::optional<NearPillarBridge>>>
+        cl_bridges(m_pillar_clusters.size());
+
+    execution::for_each(
+        suptree_ex_policy, size_t(0), m_pillar_clusters.size(),
+        [this, &cl_centroids, &cl_pillars, &cl_bridges](size_t ci) {
+            m_thr();
 
-        auto cidx = cl_centroids[ci++];
+            auto cidx = cl_centroids[ci];
+            if (cidx == NO_CENTROID) return;
+
+            auto q = m_pillar_index.query(m_builder.head(cidx).junction_point(), 1);
+            if (q.empty()) return;
 
-        auto q = m_pillar_index.query(m_builder.head(cidx).junction_point(), 1);
-        if (!q.empty()) {
             long centerpillarID = q.front().second;
-            for (auto c : cl) {
+            cl_pillars[ci] = centerpillarID;
+
+            const PtIndices &cl = m_pillar_clusters[ci];
+            cl_bridges[ci].resize(cl.size());
+            for (size_t i = 0; i < cl.size(); ++i) {
                 m_thr();
-                if (c == cidx) continue;
+                if (cl[i] == cidx) continue;
+
+                cl_bridges[ci][i] =
+                    search_nearpillar_bridge(m_builder.head(cl[i]),
+                                             m_builder.pillar(centerpillarID));
+            }
+        },
+        execution::max_concurrency(suptree_ex_policy));
 
-                auto &sidehead = m_builder.head(c);
+    for (size_t ci = 0; ci < m_pillar_clusters.size(); ++ci) {
+        long centerpillarID = cl_pillars[ci];
+        if (centerpillarID < 0) continue;
 
-                if (!connect_to_nearpillar(sidehead, centerpillarID) &&
-                    !search_pillar_and_connect(sidehead)) {
-                    // Vec3d pend = Vec3d{pstart.x(), pstart.y(), gndlvl};
-                    // Could not find a pillar, create one
-                    create_ground_pillar(sidehead.junction(), sidehead.dir, sidehead.id);
-                }
+        const PtIndices &cl = m_pillar_clusters[ci];
+        for (size_t i = 0; i < cl.size(); ++i) {
+            m_thr();
+            if (cl[i] == cl_centroids[ci]) continue;
+
+            auto &sidehead = m_builder.head(cl[i]);
+            const auto &br = cl_bridges[ci][i];
+
+            if (!(br && add_nearpillar_bridge(sidehead, centerpillarID, *br)) &&
+                !search_pillar_and_connect(sidehead)) {
+                // Vec3d pend = Vec3d{pstart.x(), pstart.y(), gndlvl};
+                // Could not find a pillar, create one
+                create_ground_pillar(sidehead.junction(), sidehead.dir, sidehead.id);
             }
         }
     }
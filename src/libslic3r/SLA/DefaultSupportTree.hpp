@@ -177,6 +177,21 @@ class DefaultSupportTree {
     // For connecting a head to a nearby pillar.
     bool connect_to_nearpillar(const Head& head, long nearpillar_id);
 
+    // A bridge from a head to a nearby pillar. It starts lower than the
+    // head if a partial pillar under the head is needed.
+    struct NearPillarBridge { Vec3d startp, endp; bool partial_pillar; };
+
+    // The geometric part of connect_to_nearpillar(), it does not modify
+    // the support tree.
+    std::optional<NearPillarBridge> search_nearpillar_bridge(
+        const Head &head, const Pillar &nearpillar);
+
+    // Adds a bridge found by search_nearpillar_bridge() unless the pillar
+    // already holds the maximum number of bridges.
+    bool add_nearpillar_bridge(const Head             &head,
+                               long                    nearpillar_id,
+                               const NearPillarBridge &br);
+
     // Find route for a head to the ground. Inserts additional bridge from the
     // head to the pillar if cannot create pillar directly.
     // The optional dir parameter is the direction of the bridge which is the
@@ -196,6 +211,11 @@ class DefaultSupportTree {
                               const Vec3d &sourcedir,
                               long         head_id = SupportTreeNode::ID_UNSET);
 
+    // Adds a route found by sla::search_ground_pillar() and saves its
+    // pillar in the spatial index.
+    bool add_ground_pillar(const GroundPillarRoute &route,
+                           long head_id = SupportTreeNode::ID_UNSET);
+
     void add_pillar_base(long pid)
     {
         m_builder.add_pillar_base(pid, m_sm.cfg.base_height_mm, m_sm.cfg.base_radius_mm);
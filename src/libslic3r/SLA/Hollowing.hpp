@@ -128,16 +128,16 @@ template<class Cont> double csgmesh_positive_maxvolume(const Cont &csg)
     return mesh_vol;
 }
 
+// Signed distance grid of the csg mesh, the input of generate_interior().
+// It depends only on the mesh and the voxel scale, not on the thickness or
+// the closing distance, thus it may be kept and reused when only these change.
 template<class It>
-InteriorPtr generate_interior(const Range<It>       &csgparts,
-                              const HollowingConfig &hc  = {},
-                              const JobController   &ctl = {})
+VoxelGridPtr generate_interior_grid(const Range<It>     &csgparts,
+                                    double               voxel_scale,
+                                    const JobController &ctl = {})
 {
-    double mesh_vol = csgmesh_positive_maxvolume(csgparts);
-    double voxsc    = get_voxel_scale(mesh_vol, hc);
-
     auto params = csg::VoxelizeParams{}
-                      .voxel_scale(voxsc)
+                      .voxel_scale(voxel_scale)
                       .exterior_bandwidth(3.f)
                       .interior_bandwidth(3.f)
                       .statusfn([&ctl](int){
@@ -149,9 +149,20 @@ InteriorPtr generate_interior(const Range<It>       &csgparts,
     if (!ptr || (ctl.stopcondition && ctl.stopcondition()))
         return {};
 
-    ptr = redistance_grid(*ptr, IsoAtZero,
-                          params.exterior_bandwidth(),
-                          params.interior_bandwidth());
+    return redistance_grid(*ptr, IsoAtZero,
+                           params.exterior_bandwidth(),
+                           params.interior_bandwidth());
+}
+
+template<class It>
+InteriorPtr generate_interior(const Range<It>       &csgparts,
+                              const HollowingConfig &hc  = {},
+                              const JobController   &ctl = {})
+{
+    double mesh_vol = csgmesh_positive_maxvolume(csgparts);
+    double voxsc    = get_voxel_scale(mesh_vol, hc);
+
+    auto ptr = generate_interior_grid(csgparts, voxsc, ctl);
 
     return ptr ? generate_interior(*ptr, hc, ctl) :
                  InteriorPtr{};
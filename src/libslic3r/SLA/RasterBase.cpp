@@ -8,12 +8,15 @@
 
 #include <libslic3r/SLA/RasterBase.hpp>
 #include <libslic3r/SLA/AGGRaster.hpp>
+#include <libslic3r/miniz_extension.hpp>
 // minz image write:
 #include <miniz.h>
 #include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 
 #include "agg/agg_gamma_functions.h"
 
@@ -25,8 +28,9 @@ EncodedRaster PNGRasterEncoder::operator()(const void *ptr, size_t w, size_t h,
     std::vector<uint8_t> buf;
     size_t s = 0;
     
-    void *rawdata = tdefl_write_image_to_png_file_in_memory(
-        ptr, int(w), int(h), int(num_components), &s);
+    // Large rasters are compressed by all cores.
+    void *rawdata = write_image_to_png_file_in_memory_parallel(
+        ptr, int(w), int(h), int(num_components), &s, MZ_DEFAULT_LEVEL, false);
     
     // On error, data() will return an empty vector. No other info can be
     // retrieved from miniz anyway...
@@ -70,7 +74,143 @@ EncodedRaster PPMRasterEncoder::operator()(const void *ptr, size_t w, size_t h,
     return EncodedRaster(std::move(buf), "ppm");
 }
 
-std::unique_ptr<RasterBase> create_raster_grayscale_aa(
+// Value of a pixel after the white foreground with the given coverage is blended over it,
+// the same as agg::pixfmt_gray8 does when rendering by agg::renderer_scanline_aa_solid.
+static uint8_t blend_white(uint8_t value, uint8_t cover)
+{
+    using TColor = agg::gray8;
+    return cover == TColor::base_mask ?
+        TColor::base_mask :
+        TColor::lerp(value, TColor::base_mask, TColor::mult_cover(TColor::base_mask, cover));
+}
+
+// Merge the covers of a newly drawn polygon into the runs of a row.
+static void merge_runs(const std::vector<RasterGrayscaleAARunLength::Run> &row,
+                       const std::vector<RasterGrayscaleAARunLength::Run> &covers,
+                       std::vector<RasterGrayscaleAARunLength::Run>       &out)
+{
+    using Run = RasterGrayscaleAARunLength::Run;
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    
+    out.clear();
+    auto append = [&out](uint32_t x, uint32_t len, uint8_t value) {
+        if (len == 0 || value == 0)
+            return;
+        if (! out.empty() && out.back().x + out.back().len == x && out.back().value == value)
+            out.back().len += len;
+        else
+            out.push_back({ x, len, value });
+    };
+    
+    // Sweep over the segments delimited by the starts and ends of the runs of both lists.
+    size_t i = 0, j = 0;
+    for (uint32_t x = 0; i < row.size() || j < covers.size();) {
+        const Run *a     = i < row.size() ? &row[i] : nullptr;
+        const Run *b     = j < covers.size() ? &covers[j] : nullptr;
+        uint32_t   a_beg = a ? std::max(a->x, x) : none;
+        uint32_t   a_end = a ? a->x + a->len : none;
+        uint32_t   b_beg = b ? std::max(b->x, x) : none;
+        uint32_t   b_end = b ? b->x + b->len : none;
+        uint32_t   beg   = std::min(a_beg, b_beg);
+        bool       in_a  = a_beg == beg;
+        bool       in_b  = b_beg == beg;
+        uint32_t   end   = std::min(in_a ? a_end : a_beg, in_b ? b_end : b_beg);
+        uint8_t    value = in_a ? a->value : 0;
+        append(beg, end - beg, in_b ? blend_white(value, b->value) : value);
+        x = end;
+        if (a && a_end <= x) ++ i;
+        if (b && b_end <= x) ++ j;
+    }
+}
+
+void RasterGrayscaleAARunLength::draw(const ExPolygon &poly)
+{
+    add_paths(m_rasterizer, poly);
+    
+    if (! m_rasterizer.rewind_scanlines())
+        return;
+    
+    const auto width = int(m_resolution.width_px);
+    m_scanlines.reset(m_rasterizer.min_x(), m_rasterizer.max_x());
+    while (m_rasterizer.sweep_scanline(m_scanlines)) {
+        const int y = m_scanlines.y();
+        if (y < 0 || y >= int(m_rows.size()))
+            continue;
+        
+        m_covers.clear();
+        auto add_cover = [this, width](int x, int len, uint8_t cover) {
+            int x1 = std::max(x, 0);
+            int x2 = std::min(x + len, width);
+            if (cover == 0 || x1 >= x2)
+                return;
+            if (! m_covers.empty() && int(m_covers.back().x + m_covers.back().len) == x1 && m_covers.back().value == cover)
+                m_covers.back().len += uint32_t(x2 - x1);
+            else
+                m_covers.push_back({ uint32_t(x1), uint32_t(x2 - x1), cover });
+        };
+        
+        // Spans with positive length carry a cover per pixel, spans with negative length a single cover.
+        unsigned num_spans = m_scanlines.num_spans();
+        auto     span      = m_scanlines.begin();
+        for (; num_spans > 0; -- num_spans, ++ span)
+            if (span->len > 0)
+                for (int i = 0; i < span->len; ++ i)
+                    add_cover(span->x + i, 1, span->covers[i]);
+            else
+                add_cover(span->x, -span->len, *span->covers);
+        
+        if (m_covers.empty())
+            continue;
+        std::vector<Run> &row = m_rows[size_t(y)];
+        if (row.empty())
+            row = m_covers;
+        else {
+            merge_runs(row, m_covers, m_merged);
+            row.swap(m_merged);
+        }
+    }
+}
+
+void RasterGrayscaleAARunLength::read_row(size_t row, uint8_t *out) const
+{
+    memset(out, 0, m_resolution.width_px);
+    for (const Run &run : m_rows[row])
+        memset(out + run.x, run.value, run.len);
+}
+
+uint8_t RasterGrayscaleAARunLength::read_pixel(size_t col, size_t row) const
+{
+    const std::vector<Run> &runs = m_rows[row];
+    auto it = std::upper_bound(runs.begin(), runs.end(), col, [](size_t x, const Run &run) { return x < run.x; });
+    return it != runs.begin() && col < std::prev(it)->x + std::prev(it)->len ? std::prev(it)->value : 0;
+}
+
+EncodedRaster RasterGrayscaleAARunLength::encode(RasterEncoder encoder) const
+{
+    const size_t w = m_resolution.width_px;
+    const size_t h = m_resolution.height_px;
+    
+    if (encoder.target<PNGRasterEncoder>() != nullptr) {
+        size_t s = 0;
+        void *rawdata = write_png_rows_to_memory_parallel(int(w), int(h), 1,
+            [this](size_t row, uint8_t *out) { read_row(row, out); }, &s, MZ_DEFAULT_LEVEL);
+        if (rawdata == nullptr) return EncodedRaster({}, "png");
+        
+        auto pptr = static_cast<std::uint8_t*>(rawdata);
+        std::vector<uint8_t> buf(pptr, pptr + s);
+        MZ_FREE(rawdata);
+        return EncodedRaster(std::move(buf), "png");
+    }
+    
+    std::vector<uint8_t> bitmap(m_resolution.pixels());
+    for (size_t row = 0; row < h; ++ row)
+        read_row(row, bitmap.data() + row * w);
+    
+    return encoder(bitmap.data(), w, h, 1);
+}
+
+template<class Raster>
+static std::unique_ptr<RasterBase> create_raster_grayscale_aa(
     const Resolution        &res,
     const PixelDim          &pxdim,
     double                   gamma,
@@ -79,15 +219,27 @@ std::unique_ptr<RasterBase> create_raster_grayscale_aa(
     std::unique_ptr<RasterBase> rst;
     
     if (gamma > 0)
-        rst = std::make_unique<RasterGrayscaleAAGammaPower>(res, pxdim, tr, gamma);
+        rst = std::make_unique<Raster>(res, pxdim, tr, agg::gamma_power(gamma));
     else if (std::abs(gamma - 1.) < 1e-6)
-        rst = std::make_unique<RasterGrayscaleAA>(res, pxdim, tr, agg::gamma_none());
+        rst = std::make_unique<Raster>(res, pxdim, tr, agg::gamma_none());
     else
-        rst = std::make_unique<RasterGrayscaleAA>(res, pxdim, tr, agg::gamma_threshold(.5));
+        rst = std::make_unique<Raster>(res, pxdim, tr, agg::gamma_threshold(.5));
     
     return rst;
 }
 
+std::unique_ptr<RasterBase> create_raster_grayscale_aa(
+    const Resolution        &res,
+    const PixelDim          &pxdim,
+    double                   gamma,
+    const RasterBase::Trafo &tr,
+    RasterStorage            storage)
+{
+    return storage == RasterStorage::RunLength ?
+        create_raster_grayscale_aa<RasterGrayscaleAARunLength>(res, pxdim, gamma, tr) :
+        create_raster_grayscale_aa<RasterGrayscaleAA>(res, pxdim, gamma, tr);
+}
+
 } // namespace sla
 } // namespace Slic3r
 
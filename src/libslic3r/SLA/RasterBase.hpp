@@ -117,12 +117,17 @@ struct PPMRasterEncoder {
 
 std::ostream& operator<<(std::ostream &stream, const EncodedRaster &bytes);
 
+// Bitmap rasters keep all the pixels in memory. Run length rasters keep
+// only the runs of the rows, which is much less for sparse layers.
+enum class RasterStorage { Bitmap, RunLength };
+
 // If gamma is zero, thresholding will be performed which disables AA.
 std::unique_ptr<RasterBase> create_raster_grayscale_aa(
     const Resolution        &res,
     const PixelDim          &pxdim,
-    double                   gamma = 1.0,
-    const RasterBase::Trafo &tr    = {});
+    double                   gamma   = 1.0,
+    const RasterBase::Trafo &tr      = {},
+    RasterStorage            storage = RasterStorage::Bitmap);
 
 }} // namespace Slic3r::sla
 
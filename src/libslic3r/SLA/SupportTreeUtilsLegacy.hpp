@@ -92,24 +92,33 @@ std::optional<DiffBridge> search_widening_path(Ex                     policy,
     return {};
 }
 
-// This is a proxy function for pillar creation which will mind the gap
-// between the pad and the model bottom in zero elevation mode.
-// 'pinhead_junctionpt' is the starting junction point which needs to be
-// routed down. sourcedir is the allowed direction of an optional bridge
-// between the jp junction and the final pillar.
+// The result of search_ground_pillar(): the elements that route a junction
+// point to the ground. Finding them does not touch the support tree, so the
+// search can run concurrently and the elements be added in a fixed order.
+struct GroundPillarRoute {
+    std::optional<DiffBridge> diffbridge; // widens a mini pillar
+    std::optional<Bridge>     bridge;     // avoids the gap of the pad
+    Vec3d  pillar_endp   = Vec3d::Zero();
+    double pillar_height = 0.;
+    double radius = 0., end_radius = 0.;
+    bool   from_head = true; // the pillar starts at the source head
+    bool   add_base  = false;
+    bool   found     = false;
+};
+
+// Searches the route of a ground pillar, see create_ground_pillar().
 template<class Ex>
-std::pair<bool, long> create_ground_pillar(
+GroundPillarRoute search_ground_pillar(
     Ex                     policy,
-    SupportTreeBuilder    &builder,
     const SupportableMesh &sm,
     const Vec3d           &pinhead_junctionpt,
     const Vec3d           &sourcedir,
     double                 radius,
-    double                 end_radius,
-    long                   head_id = SupportTreeNode::ID_UNSET)
+    double                 end_radius)
 {
+    GroundPillarRoute route;
+
     Vec3d  jp           = pinhead_junctionpt, endp = jp, dir = sourcedir;
-    long   pillar_id    = SupportTreeNode::ID_UNSET;
     bool   can_add_base = false, non_head = false;
 
     double gndlvl = 0.; // The Z level where pedestals should be
@@ -141,16 +150,14 @@ std::pair<bool, long> create_ground_pillar(
                                  sm.cfg.head_back_radius_mm);
 
         if (diffbr && diffbr->endp.z() > jp_gnd) {
-            auto &br = builder.add_diffbridge(*diffbr);
-            if (head_id >= 0) builder.head(head_id).bridge_id = br.id;
+            route.diffbridge = diffbr;
             endp = diffbr->endp;
             radius = diffbr->end_r;
             end_radius = diffbr->end_r;
-            builder.add_junction(endp, radius);
             non_head = true;
             dir = diffbr->get_dir();
             eval_limits();
-        } else return {false, pillar_id};
+        } else return route;
     }
 
     if (sm.cfg.object_elevation_mm < EPSILON)
@@ -198,31 +205,93 @@ std::pair<bool, long> create_ground_pillar(
         }
 
         // Could not find a path to avoid the pad gap
-        if (dlast < gap_dist) return {false, pillar_id};
+        if (dlast < gap_dist) return route;
 
         if (t > 0.) { // Need to make additional bridge
-            const Bridge& br = builder.add_bridge(endp, nexp, radius);
-            if (head_id >= 0) builder.head(head_id).bridge_id = br.id;
-
-            builder.add_junction(nexp, radius);
+            route.bridge = Bridge{endp, nexp, radius};
             endp = nexp;
             non_head = true;
         }
     }
 
     Vec3d gp = to_floor(endp);
-    double h = endp.z() - gp.z();
 
-    pillar_id = head_id >= 0 && !non_head ? builder.add_pillar(head_id, h) :
-                                            builder.add_pillar(gp, h, radius, end_radius);
+    route.pillar_endp   = gp;
+    route.pillar_height = endp.z() - gp.z();
+    route.radius        = radius;
+    route.end_radius    = end_radius;
+    route.from_head     = !non_head;
+    route.add_base      = can_add_base;
+    route.found         = true;
+
+    return route;
+}
+
+// Adds the elements of a route found by search_ground_pillar() to the
+// builder. The elements preceding a failed search are added as well.
+inline std::pair<bool, long> add_ground_pillar(
+    SupportTreeBuilder      &builder,
+    const SupportableMesh   &sm,
+    const GroundPillarRoute &route,
+    long                     head_id = SupportTreeNode::ID_UNSET)
+{
+    long pillar_id = SupportTreeNode::ID_UNSET;
+
+    if (route.diffbridge) {
+        auto &br = builder.add_diffbridge(*route.diffbridge);
+        if (head_id >= 0) builder.head(head_id).bridge_id = br.id;
+        builder.add_junction(route.diffbridge->endp, route.diffbridge->end_r);
+    }
+
+    if (!route.found) return {false, pillar_id};
+
+    if (route.bridge) {
+        const Bridge& br = builder.add_bridge(route.bridge->startp,
+                                              route.bridge->endp,
+                                              route.bridge->r);
+        if (head_id >= 0) builder.head(head_id).bridge_id = br.id;
+
+        builder.add_junction(route.bridge->endp, route.bridge->r);
+    }
 
-    if (can_add_base)
+    double h = route.pillar_height;
+
+    pillar_id = head_id >= 0 && route.from_head ?
+                    builder.add_pillar(head_id, h) :
+                    builder.add_pillar(route.pillar_endp, h, route.radius,
+                                       route.end_radius);
+
+    if (route.add_base)
         builder.add_pillar_base(pillar_id, sm.cfg.base_height_mm,
                                 sm.cfg.base_radius_mm);
 
     return {true, pillar_id};
 }
 
+// This is a proxy function for pillar creation which will mind the gap
+// between the pad and the model bottom in zero elevation mode.
+// 'pinhead_junctionpt' is the starting junction point which needs to be
+// routed down. sourcedir is the allowed direction of an optional bridge
+// between the jp junction and the final pillar.
+template<class Ex>
+std::pair<bool, long> create_ground_pillar(
+    Ex                     policy,
+    SupportTreeBuilder    &builder,
+    const SupportableMesh &sm,
+    const Vec3d           &pinhead_junctionpt,
+    const Vec3d           &sourcedir,
+    double                 radius,
+    double                 end_radius,
+    long                   head_id = SupportTreeNode::ID_UNSET)
+{
+    return add_ground_pillar(builder, sm,
+                             search_ground_pillar(policy, sm,
+                                                  pinhead_junctionpt,
+                                                  sourcedir, radius,
+                                                  end_radius),
+                             head_id);
+}
+
 template<class Ex>
 std::pair<bool, long> connect_to_ground(Ex                     policy,
                                         SupportTreeBuilder    &builder,
@@ -618,6 +618,7 @@ SLAPrint::ApplyStatus SLAPrint::apply(
 
     if(m_objects.empty()) {
         m_printer_input = {};
+        m_printer_input_polygons = {};
         m_print_statistics = {};
     }
 
@@ -770,6 +771,8 @@ bool SLAPrint::invalidate_step(SLAPrintStep step)
     if (step == slapsMergeSlicesAndEval) {
         invalidated |= this->invalidate_all_steps();
     }
+    if (step == slapsMergeSlicesAndEval || step == slapsRasterize)
+        m_printer_input_polygons = {};
 
     return invalidated;
 }
@@ -830,6 +833,7 @@ void SLAPrint::process()
 
                 if (po->set_started(step)) {
                     m_report_status(*this, st, printsteps.label(step));
+                    PrintProfiler::Scope profile(m_profiler, "object", printsteps.label(step), int(po->id().id));
                     bench.start();
                     printsteps.execute(step, *po);
                     bench.stop();
@@ -852,6 +856,7 @@ void SLAPrint::process()
 
         if (set_started(currentstep)) {
             m_report_status(*this, st, printsteps.label(currentstep));
+            PrintProfiler::Scope profile(m_profiler, "print", printsteps.label(currentstep));
             bench.start();
             printsteps.execute(currentstep);
             bench.stop();
@@ -431,6 +431,16 @@ private:
     };
     
     std::unique_ptr<HollowingData> m_hollowing_data;
+
+    // Signed distance grid of the assembled mesh the interior is generated from.
+    // Kept while only the thickness or the closing distance of the hollowing
+    // change, released when the mesh is assembled again.
+    struct HollowingGrid {
+        VoxelGridPtr grid;
+        double       voxel_scale = 0.;
+    };
+
+    HollowingGrid m_hollowing_grid;
 };
 
 using PrintObjects = std::vector<SLAPrintObject*>;
@@ -578,6 +588,11 @@ public:
     // TODO: use this structure for the preview in the future.
     const std::vector<PrintLayer>& print_layers() const { return m_printer_input; }
 
+    // Draw the merged model and support slices of the print layer into the raster.
+    // Thread safe, used by the archivers rasterizing the layers while exporting.
+    // The merged slices are reused from the rasterize step if it kept them, otherwise they are calculated.
+    void draw_layer(sla::RasterBase &raster, size_t layer_idx) const;
+
     void export_print(const std::string &fname, const std::string &projectname = "")
     {
         ThumbnailsList thumbnails; //empty thumbnail list
@@ -610,6 +625,9 @@ private:
 
     // Ready-made data for rasterization.
     std::vector<PrintLayer>         m_printer_input;
+    // Merged model and support slices of each print layer, kept by the rasterize step for the archivers
+    // rasterizing the layers while exporting, so that the slices are not merged again by each export.
+    std::vector<ExPolygons>         m_printer_input_polygons;
     
     // The archive object which collects the raster images after slicing
     std::unique_ptr<SLAArchiveWriter>     m_archiver;
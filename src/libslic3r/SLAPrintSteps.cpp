@@ -377,6 +377,7 @@ void SLAPrint::Steps::mesh_assembly(SLAPrintObject &po)
     po.m_mesh_to_slice.clear();
     po.m_supportdata.reset();
     po.m_hollowing_data.reset();
+    po.m_hollowing_grid = {};
 
     csg::model_to_csgmesh(*po.model_object(), po.trafo(),
                           csg_inserter{po.m_mesh_to_slice, slaposAssembly},
@@ -394,6 +395,7 @@ void SLAPrint::Steps::hollow_model(SLAPrintObject &po)
 
     if (! po.m_config.hollowing_enable.getBool()) {
         BOOST_LOG_TRIVIAL(info) << "Skipping hollowing step!";
+        po.m_hollowing_grid = {};
         return;
     }
 
@@ -407,8 +409,17 @@ void SLAPrint::Steps::hollow_model(SLAPrintObject &po)
     ctl.stopcondition = [this]() { return canceled(); };
     ctl.cancelfn = [this]() { throw_if_canceled(); };
 
-    sla::InteriorPtr interior =
-        generate_interior(po.mesh_to_slice(), hlwcfg, ctl);
+    // Only the assembled mesh is left in mesh_to_slice. Its voxelization is reused if just
+    // the thickness or the closing distance changed, these are applied to the cached grid.
+    double voxel_scale = sla::get_voxel_scale(sla::csgmesh_positive_maxvolume(po.mesh_to_slice()), hlwcfg);
+    if (! po.m_hollowing_grid.grid || po.m_hollowing_grid.voxel_scale != voxel_scale) {
+        po.m_hollowing_grid.grid        = sla::generate_interior_grid(po.mesh_to_slice(), voxel_scale, ctl);
+        po.m_hollowing_grid.voxel_scale = voxel_scale;
+    } else
+        BOOST_LOG_TRIVIAL(info) << "Reusing the distance grid of the previous hollowing!";
+
+    sla::InteriorPtr interior = po.m_hollowing_grid.grid ?
+        sla::generate_interior(*po.m_hollowing_grid.grid, hlwcfg, ctl) : sla::InteriorPtr{};
 
     if (!interior || sla::get_mesh(*interior).empty())
         BOOST_LOG_TRIVIAL(warning) << "Hollowed interior is empty!";
@@ -1191,7 +1202,8 @@ struct SLALayerInfo {
 
 
 // Going to parallel:
-static ExPolygons printlayerfn(const SLAPrint& print, size_t layer_idx, std::vector<SLALayerInfo>& layers_info)
+// If layers_info is null, only the polygons to be printed are calculated, without the statistics.
+static ExPolygons printlayerfn(const SLAPrint& print, size_t layer_idx, std::vector<SLALayerInfo>* layers_info)
 {
     const SLAPrint::PrintLayer& layer = print.print_layers()[layer_idx];
     const auto& slicerecord_references = layer.slices();
@@ -1242,16 +1254,29 @@ static ExPolygons printlayerfn(const SLAPrint& print, size_t layer_idx, std::vec
     for(ExPolygon& poly : model_polygons) trslices.emplace_back(std::move(poly));
     for(ExPolygon& poly : supports_polygons) trslices.emplace_back(std::move(poly));
 
-    const auto [layer_time, is_fast_layer] = calculate_layer_time(
-        prepare_sla_time_estimate_input(print.printer_config(), print.material_config(),
-            print.default_object_config(), layer_idx, l_height, layer_area));
+    if (layers_info) {
+        const auto [layer_time, is_fast_layer] = calculate_layer_time(
+            prepare_sla_time_estimate_input(print.printer_config(), print.material_config(),
+                print.default_object_config(), layer_idx, l_height, layer_area));
 
-    // Collect values for this layer.
-    layers_info[layer_idx] = SLALayerInfo{layer_time, layer_area, is_fast_layer, models_volume, supports_volume};
+        // Collect values for this layer.
+        (*layers_info)[layer_idx] = SLALayerInfo{layer_time, layer_area, is_fast_layer, models_volume, supports_volume};
+    }
 
     return union_ex(trslices);
 };
 
+void SLAPrint::draw_layer(sla::RasterBase &raster, size_t layer_idx) const
+{
+    if (m_printer_input_polygons.size() == m_printer_input.size()) {
+        for (const ExPolygon &poly : m_printer_input_polygons[layer_idx])
+            raster.draw(poly);
+    } else {
+        for (const ExPolygon &poly : printlayerfn(*this, layer_idx, nullptr))
+            raster.draw(poly);
+    }
+}
+
 
 
 static SLAPrintStatistics create_sla_statistics(const std::vector<SLALayerInfo>& layers_info, bool is_prusa_print)
@@ -1303,6 +1328,7 @@ void SLAPrint::Steps::rasterize()
     // pst: previous state
     double pst = current_status();
 
+    m_print->m_printer_input_polygons = {};
     initialize_printer_input();
     std::vector<PrintLayer>& printer_input = m_print->m_printer_input;
 
@@ -1317,15 +1343,11 @@ void SLAPrint::Steps::rasterize()
     // procedure to process one height level. This will run in parallel
     auto lvlfn =
         [this, &slck, increment, &dstatus, &pst, &layers_info]
-        (sla::RasterBase& raster, size_t idx)
+        (size_t idx) -> ExPolygons
     {
-        PrintLayer& printlayer = m_print->m_printer_input[idx];
-        if(canceled()) return;
+        if(canceled()) return {};
 
-        ExPolygons polys = printlayerfn(*m_print, idx, layers_info);
-
-        for (const ExPolygon& poly : polys)
-            raster.draw(poly);
+        ExPolygons polys = printlayerfn(*m_print, idx, &layers_info);
 
         // Status indication guarded with the spinlock
         {
@@ -1337,14 +1359,33 @@ void SLAPrint::Steps::rasterize()
                 pst = st;
             }
         }
+
+        return polys;
     };
 
     // last minute escape
     if(canceled()) return;
 
-    // Print all the layers in parallel
-    m_print->m_archiver->draw_layers(m_print->m_printer_input.size(), lvlfn,
-                                    [this]() { return canceled(); }, ex_tbb);
+    if (m_print->m_archiver->streams_layers()) {
+        // The archiver rasterizes the layers while exporting them, thus the encoded rasters of the whole print
+        // are never held in memory at once. Collect the statistics here and keep the merged slices for the export,
+        // they are much smaller than the encoded rasters.
+        std::vector<ExPolygons> layer_polygons(printer_input.size());
+        execution::for_each(ex_tbb, size_t(0), printer_input.size(),
+                            [&lvlfn, &layer_polygons](size_t idx) { layer_polygons[idx] = lvlfn(idx); },
+                            execution::max_concurrency(ex_tbb));
+        if (canceled())
+            return;
+        m_print->m_printer_input_polygons = std::move(layer_polygons);
+    } else {
+        // Print all the layers in parallel
+        m_print->m_archiver->draw_layers(m_print->m_printer_input.size(),
+            [&lvlfn](sla::RasterBase& raster, size_t idx) {
+                for (const ExPolygon& poly : lvlfn(idx))
+                    raster.draw(poly);
+            },
+            [this]() { return canceled(); }, ex_tbb);
+    }
 
     // Write statistics collected during rasterization.
     bool is_prusa_print = SLAPrint::is_prusa_print(m_print->printer_config().printer_model);
@@ -12,7 +12,10 @@
 
 #include "TreeModelVolumes.hpp"
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
 #include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/task_arena.h>
@@ -24,7 +27,12 @@
 #include <string>
 #include <unordered_map>
 #include <cmath>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 
 #include "TreeSupportCommon.hpp"
 #include "../BuildVolume.hpp"
@@ -62,6 +70,70 @@ static Polygons calculateMachineBorderCollision(Polygon machine_border)
 #endif
 }
 
+// Version of the disk cache file format and of the algorithms producing the cached polygons.
+// Bump it whenever the calculation of collisions or avoidances changes.
+static constexpr const uint32_t DISK_CACHE_VERSION   = 1;
+static constexpr const uint32_t DISK_CACHE_MAGIC     = 0x31564d54; // "TMV1"
+// Maximum number of files and their total size kept in the disk cache, the least recently used ones are removed.
+static constexpr const size_t   DISK_CACHE_MAX_FILES = 32;
+static constexpr const uint64_t DISK_CACHE_MAX_BYTES = uint64_t(1) << 30;
+
+static std::mutex  g_disk_cache_directory_mutex;
+static std::string g_disk_cache_directory;
+
+void TreeModelVolumes::set_disk_cache_directory(const std::string &dir)
+{
+    std::lock_guard<std::mutex> guard(g_disk_cache_directory_mutex);
+    g_disk_cache_directory = dir;
+}
+
+std::string TreeModelVolumes::disk_cache_directory()
+{
+    std::lock_guard<std::mutex> guard(g_disk_cache_directory_mutex);
+    return g_disk_cache_directory;
+}
+
+std::string TreeModelVolumes::default_disk_cache_directory()
+{
+    return data_dir().empty() ? std::string() : (boost::filesystem::path(data_dir()) / "cache" / "tree_supports").string();
+}
+
+static std::string disk_cache_file_path(const std::string &dir, uint64_t key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016" PRIx64 ".tmv", key);
+    return (boost::filesystem::path(dir) / name).string();
+}
+
+// 64bit FNV-1a hash, stable across runs, unlike std::hash.
+class DiskCacheKeyHasher
+{
+public:
+    template<typename T>
+    void operator()(const T &value) {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        this->bytes(&value, sizeof(T));
+    }
+    template<typename T, typename Allocator>
+    void operator()(const std::vector<T, Allocator> &values) {
+        (*this)(values.size());
+        for (const T &value : values)
+            (*this)(value);
+    }
+    void operator()(const Polygon &polygon) {
+        (*this)(polygon.size());
+        this->bytes(polygon.points.data(), polygon.points.size() * sizeof(Point));
+    }
+    uint64_t value() const { return m_hash; }
+
+private:
+    void bytes(const void *data, size_t size) {
+        for (const unsigned char *p = reinterpret_cast<const unsigned char*>(data), *end = p + size; p != end; ++ p)
+            m_hash = (m_hash ^ *p) * 1099511628211ull;
+    }
+    uint64_t m_hash { 14695981039346656037ull };
+};
+
 TreeModelVolumes::TreeModelVolumes(
     const PrintObject &print_object,
     const BuildVolume &build_volume,
@@ -164,10 +236,13 @@ TreeModelVolumes::TreeModelVolumes(
 #endif
 }
 
-void TreeModelVolumes::precalculate(const PrintObject& print_object, const coord_t max_layer, std::function<void()> throw_on_cancel)
+void TreeModelVolumes::precalculate(const PrintObject& print_object, const coord_t max_layer, bool lazy_avoidance, std::function<void()> throw_on_cancel)
 {
     auto t_start = std::chrono::high_resolution_clock::now();
     m_precalculated = true;
+    m_lazy_avoidance = lazy_avoidance;
+    m_throw_on_cancel = throw_on_cancel;
+    m_precalculated_from_disk_cache = false;
 
     // Get the config corresponding to one mesh that is in the current group. Which one has to be irrelevant.
     // Not the prettiest way to do this, but it ensures some calculations that may be a bit more complex
@@ -193,6 +268,19 @@ void TreeModelVolumes::precalculate(const PrintObject& print_object, const coord
 
     throw_on_cancel();
 
+    // Try to load the results of a previous precalculation of the same outlines with the same support parameters.
+    std::string cache_path;
+    uint64_t    cache_key = 0;
+    if (const std::string dir = disk_cache_directory(); ! dir.empty()) {
+        cache_key  = this->disk_cache_key(config, max_layer);
+        cache_path = disk_cache_file_path(dir, cache_key);
+        if (this->load_disk_cache(cache_path, cache_key, max_layer)) {
+            m_precalculated_from_disk_cache = true;
+            BOOST_LOG_TRIVIAL(info) << "Loaded precalculated collision and avoidance from " << cache_path;
+            return;
+        }
+    }
+
     // it may seem that the required avoidance can be of a smaller radius when going to model (no initial layer diameter for to model branches)
     // but as for every branch going towards the bp, the to model avoidance is required to check for possible merges with to model branches, this assumption is in-fact wrong.
     std::unordered_map<coord_t, LayerIndex> radius_until_layer;
@@ -250,7 +338,8 @@ void TreeModelVolumes::precalculate(const PrintObject& print_object, const coord
     // Calculate the relevant avoidances in parallel as far as possible
     {
         tbb::task_group task_group;
-        task_group.run([this, relevant_avoidance_radiis, throw_on_cancel]{ calculateAvoidance(relevant_avoidance_radiis, true, m_support_rests_on_model, throw_on_cancel); });
+        if (! m_lazy_avoidance)
+            task_group.run([this, relevant_avoidance_radiis, throw_on_cancel]{ calculateAvoidance(relevant_avoidance_radiis, true, m_support_rests_on_model, throw_on_cancel); });
         task_group.run([this, relevant_avoidance_radiis, throw_on_cancel]{ calculateWallRestrictions(relevant_avoidance_radiis, throw_on_cancel); });
         task_group.wait();
     }
@@ -261,6 +350,9 @@ void TreeModelVolumes::precalculate(const PrintObject& print_object, const coord
 //    m_precalculated = true;
     BOOST_LOG_TRIVIAL(info) << "Precalculating collision took" << dur_col << " ms. Precalculating avoidance took " << dur_avo << " ms.";
 
+    if (! cache_path.empty())
+        this->save_disk_cache(cache_path, cache_key, throw_on_cancel);
+
 #if 0
     // Paint caches into SVGs:
     auto paint_cache_into_SVGs = [this](const RadiusLayerPolygonCache &cache, std::string_view name) {
@@ -350,6 +442,11 @@ const Polygons& TreeModelVolumes::getAvoidance(const coord_t orig_radius, LayerI
         result)
         return (*result).get();
 
+    if (m_lazy_avoidance) {
+        // Expected cache miss, avoidances are calculated on demand.
+        const_cast<TreeModelVolumes*>(this)->calculateAvoidanceOnDemand(radius, layer_idx, type, to_model);
+        return getAvoidance(orig_radius, layer_idx, type, to_model, min_xy_dist);
+    }
     if (m_precalculated) {
         if (to_model) {
             BOOST_LOG_TRIVIAL(error_level_not_in_cache) << "Had to calculate Avoidance to model at radius " << radius << " and layer " << layer_idx << ", but precalculate was called. Performance may suffer!";
@@ -619,17 +716,6 @@ void TreeModelVolumes::calculateAvoidance(const std::vector<RadiusLayerPair> &ke
 {
     // For every RadiusLayer pair there are 3 avoidances that have to be calculated.
     // Prepare tasks for parallelization.
-    struct AvoidanceTask {
-        AvoidanceType   type;
-        coord_t         radius;
-        LayerIndex      max_required_layer;
-        bool            to_model;
-        LayerIndex      start_layer;
-
-        bool slow()     const { return this->type == AvoidanceType::Slow; }
-        bool holefree() const { return this->type == AvoidanceType::FastSafe; }
-    };
-
     std::vector<AvoidanceTask> avoidance_tasks;
     avoidance_tasks.reserve((int(to_build_plate) + int(to_model)) * keys.size() * size_t(AvoidanceType::Count));
 
@@ -656,48 +742,7 @@ void TreeModelVolumes::calculateAvoidance(const std::vector<RadiusLayerPair> &ke
     tbb::parallel_for(tbb::blocked_range<size_t>(0, avoidance_tasks.size(), 1),
         [this, &avoidance_tasks, &throw_on_cancel](const tbb::blocked_range<size_t> &range) {
         for (size_t task_idx = range.begin(); task_idx < range.end(); ++ task_idx) {
-            const AvoidanceTask &task = avoidance_tasks[task_idx];
-            assert(! task.holefree() || task.radius < m_increase_until_radius + m_current_min_xy_dist_delta);
-            if (task.to_model)
-                // ensuring Placeableareas are calculated
-                //FIXME pass throw_on_cancel
-                getPlaceableAreas(task.radius, task.max_required_layer, throw_on_cancel);
-            // The following loop propagating avoidance regions bottom up is inherently serial.
-            const bool  collision_holefree = (task.slow() || task.holefree()) && task.radius < m_increase_until_radius + m_current_min_xy_dist_delta;
-            const float max_move           = task.slow() ? m_max_move_slow : m_max_move;
-            // Limiting the offset step so that unioning the shrunk latest_avoidance with the current layer collisions
-            // will not create gaps in the resulting avoidance region letting a tree support branch tunneling through an object wall.
-            float move_step      = 1.9 * std::max(task.radius, m_current_min_xy_dist);
-            int   move_steps     = round_up_divide<int>(max_move, move_step);
-            assert(move_steps > 0);
-            float last_move_step = max_move - (move_steps - 1) * move_step;
-            if (last_move_step < scaled<float>(0.05)) {
-                assert(move_steps > 1);
-                if (move_steps > 1) {
-                    // Avoid taking a very short last step, stretch the other steps a bit instead.
-                    move_step = max_move / (-- move_steps);
-                    last_move_step = move_step;
-                }
-            }
-            // minDist as the delta was already added, also avoidance for layer 0 will return the collision.
-            Polygons    latest_avoidance   = getAvoidance(task.radius, task.start_layer - 1, task.type, task.to_model, true);
-            std::vector<std::pair<RadiusLayerPair, Polygons>> data;
-            data.reserve(task.max_required_layer + 1 - task.start_layer);
-            for (LayerIndex layer_idx = task.start_layer; layer_idx <= task.max_required_layer; ++ layer_idx) {
-                // Merge current layer collisions with shrunk last_avoidance.
-                const Polygons &current_layer_collisions = collision_holefree ? getCollisionHolefree(task.radius, layer_idx) : getCollision(task.radius, layer_idx, true);
-                // For mildly steep branch angles only one step will be taken.
-                for (int istep = 0; istep < move_steps; ++ istep)
-                    latest_avoidance = union_(current_layer_collisions,
-                        offset(latest_avoidance,
-                            istep + 1 == move_steps ? - last_move_step : - move_step,
-                            ClipperLib::jtRound, m_min_resolution));
-                if (task.to_model)
-                    latest_avoidance = diff(latest_avoidance, getPlaceableAreas(task.radius, layer_idx, throw_on_cancel));
-                latest_avoidance = polygons_simplify(latest_avoidance, m_min_resolution, polygons_strictly_simple);
-                data.emplace_back(RadiusLayerPair{task.radius, layer_idx}, latest_avoidance);
-                throw_on_cancel();
-            }
+            this->calculateAvoidance(avoidance_tasks[task_idx], throw_on_cancel);
 #ifdef SLIC3R_TREESUPPORTS_PROGRESS
             {
                 std::lock_guard<std::mutex> critical_section(*m_critical_progress);
@@ -709,11 +754,105 @@ void TreeModelVolumes::calculateAvoidance(const std::vector<RadiusLayerPair> &ke
                 }
             }
 #endif
-            avoidance_cache(task.type, task.to_model).insert(std::move(data));
         }
     });
 }
 
+void TreeModelVolumes::calculateAvoidance(const AvoidanceTask &task, std::function<void()> throw_on_cancel)
+{
+    assert(! task.holefree() || task.radius < m_increase_until_radius + m_current_min_xy_dist_delta);
+    if (task.to_model)
+        // ensuring Placeableareas are calculated
+        //FIXME pass throw_on_cancel
+        getPlaceableAreas(task.radius, task.max_required_layer, throw_on_cancel);
+    // The following loop propagating avoidance regions bottom up is inherently serial.
+    const bool  collision_holefree = (task.slow() || task.holefree()) && task.radius < m_increase_until_radius + m_current_min_xy_dist_delta;
+    const float max_move           = task.slow() ? m_max_move_slow : m_max_move;
+    // Limiting the offset step so that unioning the shrunk latest_avoidance with the current layer collisions
+    // will not create gaps in the resulting avoidance region letting a tree support branch tunneling through an object wall.
+    float move_step      = 1.9 * std::max(task.radius, m_current_min_xy_dist);
+    int   move_steps     = round_up_divide<int>(max_move, move_step);
+    assert(move_steps > 0);
+    float last_move_step = max_move - (move_steps - 1) * move_step;
+    if (last_move_step < scaled<float>(0.05)) {
+        assert(move_steps > 1);
+        if (move_steps > 1) {
+            // Avoid taking a very short last step, stretch the other steps a bit instead.
+            move_step = max_move / (-- move_steps);
+            last_move_step = move_step;
+        }
+    }
+    // minDist as the delta was already added, also avoidance for layer 0 will return the collision.
+    Polygons    latest_avoidance   = getAvoidance(task.radius, task.start_layer - 1, task.type, task.to_model, true);
+    std::vector<std::pair<RadiusLayerPair, Polygons>> data;
+    data.reserve(task.max_required_layer + 1 - task.start_layer);
+    for (LayerIndex layer_idx = task.start_layer; layer_idx <= task.max_required_layer; ++ layer_idx) {
+        // Merge current layer collisions with shrunk last_avoidance.
+        const Polygons &current_layer_collisions = collision_holefree ? getCollisionHolefree(task.radius, layer_idx) : getCollision(task.radius, layer_idx, true);
+        // For mildly steep branch angles only one step will be taken.
+        for (int istep = 0; istep < move_steps; ++ istep)
+            latest_avoidance = union_(current_layer_collisions,
+                offset(latest_avoidance,
+                    istep + 1 == move_steps ? - last_move_step : - move_step,
+                    ClipperLib::jtRound, m_min_resolution));
+        if (task.to_model)
+            latest_avoidance = diff(latest_avoidance, getPlaceableAreas(task.radius, layer_idx, throw_on_cancel));
+        latest_avoidance = polygons_simplify(latest_avoidance, m_min_resolution, polygons_strictly_simple);
+        data.emplace_back(RadiusLayerPair{task.radius, layer_idx}, latest_avoidance);
+        throw_on_cancel();
+    }
+    avoidance_cache(task.type, task.to_model).insert(std::move(data));
+}
+
+void TreeModelVolumes::calculateAvoidanceOnDemand(const coord_t radius, const LayerIndex layer_idx, const AvoidanceType type, const bool to_model)
+{
+    assert(radius == this->ceilRadius(radius));
+    assert(type != AvoidanceType::FastSafe || radius < m_increase_until_radius + m_current_min_xy_dist_delta);
+    const auto               key   = std::make_tuple(radius, type, to_model);
+    RadiusLayerPolygonCache &cache = this->avoidance_cache(type, to_model);
+    for (;;) {
+        std::shared_future<void> other;
+        std::promise<void>       promise;
+        AvoidanceTask            task{ type, radius, layer_idx, to_model, 0 };
+        {
+            std::lock_guard<std::mutex> guard(*m_avoidance_in_progress_mutex);
+            if (cache.getArea({ radius, layer_idx }))
+                return;
+            if (auto it = m_avoidance_in_progress.find(key); it != m_avoidance_in_progress.end())
+                other = it->second;
+            else {
+                // Ensure start_layer is at least 1 as if no avoidance was calculated yet getMaxCalculatedLayer() returns -1.
+                task.start_layer = std::max<LayerIndex>(1, 1 + cache.getMaxCalculatedLayer(radius));
+                m_avoidance_in_progress.emplace(key, promise.get_future().share());
+            }
+        }
+        if (other.valid()) {
+            // Another thread is extending this avoidance, wait for it and then check whether it reached our layer.
+            // Rethrows the exception of the other thread, for example if it was canceled.
+            other.get();
+            continue;
+        }
+        try {
+            // Isolate the nested parallelism, so that this thread does not pick up a task waiting for the avoidance it is just calculating.
+            tbb::this_task_arena::isolate([this, &task]{ this->calculateAvoidance(task, m_throw_on_cancel); });
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> guard(*m_avoidance_in_progress_mutex);
+                m_avoidance_in_progress.erase(key);
+            }
+            // Release the threads waiting for this avoidance with the same exception.
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+        {
+            std::lock_guard<std::mutex> guard(*m_avoidance_in_progress_mutex);
+            m_avoidance_in_progress.erase(key);
+        }
+        promise.set_value();
+        return;
+    }
+}
+
 
 void TreeModelVolumes::calculatePlaceables(const std::vector<RadiusLayerPair> &keys, std::function<void()> throw_on_cancel)
 {
@@ -860,6 +999,207 @@ coord_t TreeModelVolumes::ceilRadius(const coord_t radius) const
     return out;
 }
 
+std::vector<TreeModelVolumes::RadiusLayerPolygonCache*> TreeModelVolumes::precalculated_caches()
+{
+    return {
+        &m_collision_cache, &m_collision_cache_holefree,
+        &m_avoidance_cache, &m_avoidance_cache_slow, &m_avoidance_cache_to_model, &m_avoidance_cache_to_model_slow,
+        &m_placeable_areas_cache, &m_avoidance_cache_holefree, &m_avoidance_cache_holefree_to_model,
+        &m_wall_restrictions_cache, &m_wall_restrictions_cache_min
+    };
+}
+
+uint64_t TreeModelVolumes::disk_cache_key(const TreeSupportSettings &config, LayerIndex max_layer) const
+{
+    DiskCacheKeyHasher hash;
+    hash(DISK_CACHE_VERSION);
+    hash(sizeof(coord_t));
+    hash(max_layer);
+    // Geometry of the object, support blockers and bed.
+    for (const auto &[settings, outlines] : m_layer_outlines) {
+        hash(settings.layer_height);
+        hash(settings.resolution);
+        hash(settings.support_xy_distance);
+        hash(settings.support_top_distance);
+        hash(settings.support_bottom_distance);
+        hash(outlines);
+    }
+    hash(m_current_outline_idx);
+    hash(m_anti_overhang);
+    hash(m_machine_border);
+    // Parameters derived by the constructor.
+    hash(m_max_move);
+    hash(m_max_move_slow);
+    hash(m_min_resolution);
+    hash(m_current_min_xy_dist);
+    hash(m_current_min_xy_dist_delta);
+    hash(m_increase_until_radius);
+    hash(m_radius_0);
+    hash(m_support_rests_on_model);
+    hash(m_raft_layers);
+    // Lazy mode leaves the avoidances out of the cache.
+    hash(m_lazy_avoidance);
+    // Parameters of the branches deciding which radii are precalculated up to which layer.
+    hash(TreeSupportSettings::soluble);
+    hash(config.branch_radius);
+    hash(config.min_radius);
+    hash(config.tip_layers);
+    hash(config.branch_radius_increase_per_layer);
+    hash(config.bp_radius);
+    hash(config.layer_start_bp_radius);
+    hash(config.bp_radius_increase_per_layer);
+    hash(config.increase_radius_until_radius);
+    hash(config.xy_distance);
+    hash(config.xy_min_distance);
+    return hash.value();
+}
+
+// Binary file of all caches filled by precalculate(). The file is only readable by the same build on the same platform,
+// which is checked by the magic, version and size of coord_t in the header, the key is checked against the expected one.
+// A file that cannot be read is treated as a cache miss and it is deleted.
+bool TreeModelVolumes::load_disk_cache(const std::string &path, uint64_t key, LayerIndex max_layer)
+{
+    boost::system::error_code ec;
+    if (! boost::filesystem::exists(path, ec))
+        return false;
+
+    std::vector<RadiusLayerPolygonCache*> caches = this->precalculated_caches();
+    std::vector<std::vector<std::pair<RadiusLayerPair, Polygons>>> data(caches.size());
+    bool loaded = false;
+    try {
+        const uint64_t file_size = boost::filesystem::file_size(path);
+        boost::nowide::ifstream file(path, std::ios::binary);
+        // Number of bytes not read yet, all the counts read from the file are checked against it
+        // before anything is allocated.
+        uint64_t bytes_left = file_size;
+        auto read = [&file, &bytes_left](auto &value) {
+            if (bytes_left < sizeof(value))
+                return false;
+            file.read(reinterpret_cast<char*>(&value), sizeof(value));
+            bytes_left -= sizeof(value);
+            return bool(file);
+        };
+        auto read_all = [&]() {
+            uint32_t magic, version, coord_size;
+            uint64_t file_key;
+            if (! file || ! read(magic) || ! read(version) || ! read(coord_size) || ! read(file_key) ||
+                magic != DISK_CACHE_MAGIC || version != DISK_CACHE_VERSION || coord_size != sizeof(coord_t) || file_key != key)
+                return false;
+            for (std::vector<std::pair<RadiusLayerPair, Polygons>> &cache_data : data) {
+                // Smallest possible entry: radius, layer index and number of polygons.
+                static constexpr const uint64_t min_entry_size = sizeof(int64_t) + sizeof(int32_t) + sizeof(uint64_t);
+                uint64_t num_entries;
+                if (! read(num_entries) || num_entries > bytes_left / min_entry_size)
+                    return false;
+                cache_data.reserve(size_t(num_entries));
+                for (uint64_t i = 0; i < num_entries; ++ i) {
+                    int64_t  radius;
+                    int32_t  layer_idx;
+                    uint64_t num_polygons;
+                    if (! read(radius) || ! read(layer_idx) || ! read(num_polygons) || layer_idx < 0 || layer_idx > max_layer ||
+                        num_polygons > bytes_left / sizeof(uint64_t))
+                        return false;
+                    Polygons polygons(size_t(num_polygons), Polygon{});
+                    for (Polygon &polygon : polygons) {
+                        uint64_t num_points;
+                        if (! read(num_points) || num_points > bytes_left / sizeof(Point))
+                            return false;
+                        polygon.points.resize(size_t(num_points));
+                        file.read(reinterpret_cast<char*>(polygon.points.data()), std::streamsize(num_points * sizeof(Point)));
+                        bytes_left -= num_points * sizeof(Point);
+                        if (! file)
+                            return false;
+                    }
+                    cache_data.emplace_back(RadiusLayerPair{ coord_t(radius), LayerIndex(layer_idx) }, std::move(polygons));
+                }
+            }
+            uint32_t end_magic;
+            return read(end_magic) && end_magic == DISK_CACHE_MAGIC && bytes_left == 0;
+        };
+        loaded = read_all();
+    } catch (const std::exception &ex) {
+        BOOST_LOG_TRIVIAL(warning) << "Failed reading the tree support cache file " << path << ": " << ex.what();
+        loaded = false;
+    }
+    if (! loaded) {
+        BOOST_LOG_TRIVIAL(warning) << "Removing invalid tree support cache file " << path;
+        boost::filesystem::remove(path, ec);
+        return false;
+    }
+
+    for (size_t i = 0; i < caches.size(); ++ i)
+        caches[i]->insert(std::move(data[i]));
+    // Mark the file as recently used.
+    boost::filesystem::last_write_time(path, std::time(nullptr), ec);
+    return true;
+}
+
+void TreeModelVolumes::save_disk_cache(const std::string &path, uint64_t key, std::function<void()> throw_on_cancel)
+{
+    const boost::filesystem::path dir = boost::filesystem::path(path).parent_path();
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(dir, ec);
+    if (ec) {
+        BOOST_LOG_TRIVIAL(warning) << "Cannot create the tree support cache directory " << dir.string() << ": " << ec.message();
+        return;
+    }
+
+    // Write into a temporary file first, so that a concurrently running slicer never reads a partially written file.
+    const std::string path_tmp = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    try {
+        boost::nowide::ofstream file(path_tmp, std::ios::binary);
+        auto write = [&file](const auto &value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        write(DISK_CACHE_MAGIC);
+        write(DISK_CACHE_VERSION);
+        write(uint32_t(sizeof(coord_t)));
+        write(key);
+        for (const RadiusLayerPolygonCache *cache : this->precalculated_caches()) {
+            throw_on_cancel();
+            const std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> entries = cache->sorted();
+            write(uint64_t(entries.size()));
+            for (const auto &[radius_layer, polygons] : entries) {
+                write(int64_t(radius_layer.first));
+                write(int32_t(radius_layer.second));
+                write(uint64_t(polygons.get().size()));
+                for (const Polygon &polygon : polygons.get()) {
+                    write(uint64_t(polygon.size()));
+                    file.write(reinterpret_cast<const char*>(polygon.points.data()), std::streamsize(polygon.points.size() * sizeof(Point)));
+                }
+            }
+        }
+        write(DISK_CACHE_MAGIC);
+        if (! file) {
+            BOOST_LOG_TRIVIAL(warning) << "Failed writing the tree support cache file " << path_tmp;
+            file.close();
+            boost::filesystem::remove(path_tmp, ec);
+            return;
+        }
+    } catch (...) {
+        // Canceled, don't leave the partially written file behind.
+        boost::filesystem::remove(path_tmp, ec);
+        throw;
+    }
+    boost::filesystem::rename(path_tmp, path, ec);
+    if (ec) {
+        boost::filesystem::remove(path_tmp, ec);
+        return;
+    }
+
+    // Remove the least recently used files above the limits, the file just written is always kept.
+    std::vector<std::pair<std::time_t, boost::filesystem::path>> files;
+    for (boost::filesystem::directory_iterator it(dir, ec), end; ! ec && it != end; it.increment(ec))
+        if (it->path().extension() == ".tmv")
+            files.emplace_back(boost::filesystem::last_write_time(it->path(), ec), it->path());
+    std::sort(files.begin(), files.end(), [](const auto &l, const auto &r) { return l.first > r.first; });
+    uint64_t total_bytes = 0;
+    for (size_t i = 0; i < files.size(); ++ i) {
+        const uintmax_t size = boost::filesystem::file_size(files[i].second, ec);
+        total_bytes += ec ? 0 : uint64_t(size);
+        if (files[i].second != boost::filesystem::path(path) && (i >= DISK_CACHE_MAX_FILES || total_bytes > DISK_CACHE_MAX_BYTES))
+            boost::filesystem::remove(files[i].second, ec);
+    }
+}
+
 void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(size_t num_layers)
 {
     if (num_layers > m_data.size()) {
@@ -869,7 +1209,7 @@ void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(size_t num_layer
     }
 }
 
-// For debugging purposes, sorted by layer index, then by radius.
+// Sorted by layer index, then by radius. Used for debugging and to serialize the caches into the disk cache in a stable order.
 std::vector<std::pair<TreeModelVolumes::RadiusLayerPair, std::reference_wrapper<const Polygons>>> TreeModelVolumes::RadiusLayerPolygonCache::sorted() const
 {
     std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> out;
@@ -20,8 +20,12 @@
 #include <mutex>
 #include <unordered_map>
 #include <functional>
+#include <future>
 #include <map>
+#include <memory>
 #include <optional>
+#include <tuple>
+#include <string>
 #include <utility>
 #include <vector>
 #include <cassert>
@@ -97,8 +101,27 @@ public:
      *
      * Knowledge about branch angle is used to only calculate avoidances and collisions that may actually be needed.
      * Not calling precalculate() will cause the class to lazily calculate avoidances and collisions as needed, which will be a lot slower on systems with more then one or two cores!
+     *
+     * With \p lazy_avoidance, only collisions, placeable areas and wall restrictions are precalculated. Avoidances are calculated
+     * on demand for the (radius, layer) pairs queried by getAvoidance(), concurrent requests of the same avoidance share a single calculation.
+     * This pays off if the branches reach just a small fraction of the radius x layer matrix, for example with small contact areas on tall models.
      */
-    void precalculate(const PrintObject& print_object, const coord_t max_layer, std::function<void()> throw_on_cancel);
+    void precalculate(const PrintObject& print_object, const coord_t max_layer, bool lazy_avoidance, std::function<void()> throw_on_cancel);
+
+    /*!
+     * \brief Directory of the persistent cache of precalculated collisions and avoidances.
+     *
+     * precalculate() stores its results into this directory, keyed by a hash of the layer outlines and of the support parameters,
+     * and loads them back when the same object is sliced again with the same support parameters.
+     * The cache file is written synchronously by precalculate() and it may grow large, thus the cache is disabled by default
+     * (empty directory) and it has to be enabled by the application, see default_disk_cache_directory().
+     */
+    static void        set_disk_cache_directory(const std::string &dir);
+    static std::string disk_cache_directory();
+    // data_dir()/cache/tree_supports, empty if data_dir() is not set.
+    static std::string default_disk_cache_directory();
+    // Were the caches filled from the disk cache by the last call to precalculate()?
+    bool               precalculated_from_disk_cache() const { return m_precalculated_from_disk_cache; }
 
     /*!
      * \brief Provides the areas that have to be avoided by the tree's branches to prevent collision with the model on this layer.
@@ -376,6 +399,18 @@ private:
         calculateCollisionHolefree(std::vector<RadiusLayerPair>{ RadiusLayerPair(key) }, []{});
     }
 
+    // Propagation of one avoidance type of a single radius from start_layer up to max_required_layer.
+    struct AvoidanceTask {
+        AvoidanceType   type;
+        coord_t         radius;
+        LayerIndex      max_required_layer;
+        bool            to_model;
+        LayerIndex      start_layer;
+
+        bool slow()     const { return this->type == AvoidanceType::Slow; }
+        bool holefree() const { return this->type == AvoidanceType::FastSafe; }
+    };
+
     /*!
      * \brief Creates the areas that have to be avoided by the tree's branches to prevent collision with the model.
      *
@@ -384,6 +419,14 @@ private:
      * \param keys RadiusLayerPairs of all requested areas. Every radius will be calculated up to the provided layer.
      */
     void calculateAvoidance(const std::vector<RadiusLayerPair> &keys, bool to_build_plate, bool to_model, std::function<void()> throw_on_cancel);
+    void calculateAvoidance(const AvoidanceTask &task, std::function<void()> throw_on_cancel);
+    /*!
+     * \brief Creates a single avoidance type of the given radius up to the given layer, used if the avoidances are not precalculated.
+     *
+     * If another thread is already calculating the same avoidance, waits for its result instead of calculating it again.
+     * \param radius Radius of the requested avoidance, already snapped to grid.
+     */
+    void calculateAvoidanceOnDemand(coord_t radius, LayerIndex layer_idx, AvoidanceType type, bool to_model);
 
     /*!
      * \brief Creates the areas that have to be avoided by the tree's branches to prevent collision with the model.
@@ -431,6 +474,13 @@ private:
         calculateWallRestrictions(std::vector<RadiusLayerPair>{ RadiusLayerPair(key) }, []{});
     }
 
+    // All caches filled by precalculate(), in the order they are stored in the disk cache.
+    std::vector<RadiusLayerPolygonCache*> precalculated_caches();
+    // Hash of all inputs of precalculate().
+    uint64_t disk_cache_key(const TreeSupportSettings &config, LayerIndex max_layer) const;
+    bool     load_disk_cache(const std::string &path, uint64_t key, LayerIndex max_layer);
+    void     save_disk_cache(const std::string &path, uint64_t key, std::function<void()> throw_on_cancel);
+
     /*!
      * \brief The maximum distance that the center point of a tree branch may move in consecutive layers if it has to avoid the model.
      */
@@ -446,6 +496,9 @@ private:
     coord_t m_min_resolution;
 
     bool m_precalculated = false;
+    bool m_precalculated_from_disk_cache = false;
+    // Avoidances are not precalculated, but calculated on demand, see precalculate().
+    bool m_lazy_avoidance = false;
     /*!
      * \brief The index to access the outline corresponding with the currently processing mesh
      */
@@ -561,6 +614,13 @@ private:
     // restriction would be slower.    
     RadiusLayerPolygonCache     m_wall_restrictions_cache_min;
 
+    // Avoidances being calculated on demand, keyed by radius, avoidance type and to_model.
+    // Signalled once the calculating thread finished, holding its exception if it failed or was canceled.
+    std::map<std::tuple<coord_t, AvoidanceType, bool>, std::shared_future<void>> m_avoidance_in_progress;
+    std::unique_ptr<std::mutex> m_avoidance_in_progress_mutex { std::make_unique<std::mutex>() };
+    // Cancellation callback passed to precalculate(), used by the avoidances calculated on demand.
+    std::function<void()>       m_throw_on_cancel { []{} };
+
 #ifdef SLIC3R_TREESUPPORTS_PROGRESS
     std::unique_ptr<std::mutex> m_critical_progress { std::make_unique<std::mutex>() };
 #endif // SLIC3R_TREESUPPORTS_PROGRESS
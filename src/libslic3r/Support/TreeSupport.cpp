@@ -354,19 +354,26 @@ static std::vector<std::pair<TreeSupportSettings, std::vector<size_t>>> group_me
 {
     // calculate top most layer that is relevant for support
     LayerIndex max_layer = 0;
+    size_t     num_overhang_layers = 0;
     for (size_t object_id : object_ids) {
         const PrintObject &print_object      = *print.get_object(object_id);
         const int       num_raft_layers      = int(config.raft_layers.size());
         const int       num_layers           = int(print_object.layer_count()) + num_raft_layers;
         int             max_support_layer_id = 0;
         for (int layer_id = std::max<int>(num_raft_layers, 1); layer_id < num_layers; ++ layer_id)
-            if (! overhangs[layer_id].empty())
+            if (! overhangs[layer_id].empty()) {
                 max_support_layer_id = layer_id;
+                ++ num_overhang_layers;
+            }
         max_layer = std::max(max_support_layer_id - int(config.z_distance_top_layers), 0);
     }
-    if (max_layer > 0)
+    if (max_layer > 0) {
+        // If just a few layers contain overhangs, just a few branches grow down through a tall stack of layers,
+        // querying a small part of the radius x layer matrix of avoidances. Calculate the avoidances on demand then.
+        const bool lazy_avoidance = num_overhang_layers * 8 < size_t(max_layer);
         // The actual precalculation happens in TreeModelVolumes.
-        volumes.precalculate(*print.get_object(object_ids.front()), max_layer, throw_on_cancel);
+        volumes.precalculate(*print.get_object(object_ids.front()), max_layer, lazy_avoidance, throw_on_cancel);
+    }
     return max_layer;
 }
 
@@ -26,6 +26,7 @@
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/concurrent_vector.h>
 #include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_sort.h>
 #include <cmath>
 #include <vector>
 #include <utility>
@@ -725,7 +726,8 @@ int its_merge_vertices(indexed_triangle_set &its, bool shrink_to_fit)
     auto sorted = reserve_vector<int>(its.vertices.size());
     for (int i = 0; i < int(its.vertices.size()); ++ i)
         sorted.emplace_back(i);
-    std::sort(sorted.begin(), sorted.end(), [&its](int il, int ir) {
+    // The ordering is total, thus the parallel sort produces the same result as a sequential one.
+    tbb::parallel_sort(sorted.begin(), sorted.end(), [&its](int il, int ir) {
         const Vec3f &l = its.vertices[il];
         const Vec3f &r = its.vertices[ir];
         // Sort lexicographically by coordinates AND vertex index.
@@ -770,9 +772,11 @@ int its_merge_vertices(indexed_triangle_set &its, bool shrink_to_fit)
         // Shrink the vertices.
         its.vertices.erase(its.vertices.begin() + k, its.vertices.end());
         // Remap face indices.
-        for (stl_triangle_vertex_indices &face : its.indices)
+        execution::for_each(ex_tbb, size_t(0), its.indices.size(), [&its, &map_vertices](size_t face_idx) {
+            stl_triangle_vertex_indices &face = its.indices[face_idx];
             for (int i = 0; i < 3; ++ i)
                 face(i) = map_vertices[face(i)];
+        }, 4096);
         // Optionally shrink to fit (reallocate) vertices.
         if (shrink_to_fit)
             its.vertices.shrink_to_fit();
@@ -839,6 +843,99 @@ int its_compactify_vertices(indexed_triangle_set &its, bool shrink_to_fit)
     return removed;
 }
 
+int its_fix_face_orientations(indexed_triangle_set &its)
+{
+    const size_t num_faces = its.indices.size();
+    if (num_faces == 0)
+        return 0;
+
+    // 1) Collect face edges and sort them by their vertex indices, ignoring the edge direction.
+    struct FaceEdge {
+        // Vertex indices of the edge, vertex_low < vertex_high.
+        int vertex_low;
+        int vertex_high;
+        // face_idx * 3 + edge_idx
+        int face_edge;
+        bool same_edge(const FaceEdge &rhs) const { return this->vertex_low == rhs.vertex_low && this->vertex_high == rhs.vertex_high; }
+    };
+    std::vector<FaceEdge> edges(num_faces * 3);
+    execution::for_each(ex_tbb, size_t(0), num_faces, [&its, &edges](size_t face_idx) {
+        for (int edge_idx = 0; edge_idx < 3; ++ edge_idx) {
+            const Vec2i edge = its_triangle_edge(its.indices[face_idx], edge_idx);
+            edges[face_idx * 3 + edge_idx] = { std::min(edge(0), edge(1)), std::max(edge(0), edge(1)), int(face_idx * 3 + edge_idx) };
+        }
+    }, 4096);
+    tbb::parallel_sort(edges.begin(), edges.end(), [](const FaceEdge &l, const FaceEdge &r) {
+        return l.vertex_low < r.vertex_low || (l.vertex_low == r.vertex_low && (l.vertex_high < r.vertex_high || (l.vertex_high == r.vertex_high && l.face_edge < r.face_edge)));
+    });
+
+    // 2) Neighbor face over each face edge. Only manifold edges, which are shared by exactly two faces, connect faces.
+    std::vector<int> neighbors(num_faces * 3, -1);
+    execution::for_each(ex_tbb, size_t(0), edges.size(), [&edges, &neighbors](size_t i) {
+        // Each run of the same edges is processed by the iteration at its start.
+        if (i > 0 && edges[i - 1].same_edge(edges[i]))
+            return;
+        if (i + 1 < edges.size() && edges[i].same_edge(edges[i + 1]) && (i + 2 == edges.size() || ! edges[i].same_edge(edges[i + 2]))) {
+            neighbors[edges[i].face_edge]     = edges[i + 1].face_edge / 3;
+            neighbors[edges[i + 1].face_edge] = edges[i].face_edge / 3;
+        }
+    }, 4096);
+    edges = {};
+
+    // 3) Walk the patches of connected faces depth first, orient the faces consistently with the first face of each patch.
+    // The order of the walk does not matter, a stack is cheaper than a FIFO queue.
+    // Faces are flipped after the walk, thus the edge indices of the neighbor index remain valid during the walk.
+    std::vector<char> visited(num_faces, false);
+    std::vector<char> flip(num_faces, false);
+    std::vector<int>  stack;
+    for (size_t seed = 0; seed < num_faces; ++ seed) {
+        if (visited[seed])
+            continue;
+        visited[seed] = true;
+        stack.assign(1, int(seed));
+        while (! stack.empty()) {
+            const int face_idx = stack.back();
+            stack.pop_back();
+            for (int edge_idx = 0; edge_idx < 3; ++ edge_idx) {
+                const int neighbor = neighbors[face_idx * 3 + edge_idx];
+                if (neighbor == -1 || visited[neighbor])
+                    continue;
+                // A consistently oriented neighbor contains the shared edge in the opposite direction.
+                const bool same_direction = its_triangle_edge_index(its.indices[neighbor], its_triangle_edge(its.indices[face_idx], edge_idx)) != -1;
+                flip[neighbor]    = flip[face_idx] != same_direction;
+                visited[neighbor] = true;
+                stack.emplace_back(neighbor);
+            }
+        }
+    }
+
+    // 4) Flip the faces.
+    return execution::reduce(ex_tbb, size_t(0), num_faces, 0, std::plus<int>{}, [&its, &flip](size_t face_idx) {
+        if (! flip[face_idx])
+            return 0;
+        std::swap(its.indices[face_idx](1), its.indices[face_idx](2));
+        return 1;
+    }, 4096);
+}
+
+RepairedMeshErrors its_repair(indexed_triangle_set &its)
+{
+    RepairedMeshErrors errors;
+    its_merge_vertices(its, false);
+    errors.degenerate_facets = its_remove_degenerate_faces(its, false);
+    errors.facets_removed    = errors.degenerate_facets;
+    if (errors.degenerate_facets > 0)
+        its_compactify_vertices(its, false);
+    errors.facets_reversed   = its_fix_face_orientations(its);
+    // Same as admesh stl_calculate_volume(), which flips all faces of a mesh with a negative volume.
+    if (its_volume(its) < 0) {
+        its_flip_triangles(its);
+        errors.facets_reversed += int(its.indices.size());
+    }
+    its_shrink_to_fit(its);
+    return errors;
+}
+
 bool its_store_triangle_to_obj(const indexed_triangle_set &its,
                                const char                 *obj_filename,
                                size_t                      triangle_index)
@@ -265,6 +265,15 @@ int its_remove_degenerate_faces(indexed_triangle_set &its, bool shrink_to_fit =
 // Remove vertices, which none of the faces references. Return number of freed vertices.
 int its_compactify_vertices(indexed_triangle_set &its, bool shrink_to_fit = true);
 
+// Orient faces of each patch of faces connected over manifold edges consistently with the first face of the patch,
+// return number of faces flipped. Same as admesh stl_fix_normal_directions(), the edges are indexed in parallel.
+int its_fix_face_orientations(indexed_triangle_set &its);
+
+// Parallel alternative to the admesh repair of an imported mesh: merges vertices with the same coordinates,
+// removes degenerate faces, orients faces consistently and flips all faces if the volume is negative.
+// In contrast to admesh, open edges are not closed by merging nearby vertices and unconnected faces are kept.
+RepairedMeshErrors its_repair(indexed_triangle_set &its);
+
 // store part of index triangle set
 bool its_store_triangle_to_obj(const indexed_triangle_set &its, const char *obj_filename, size_t triangle_index);
 bool its_store_triangles_to_obj(const indexed_triangle_set &its, const char *obj_filename, const std::vector<size_t>& triangles);
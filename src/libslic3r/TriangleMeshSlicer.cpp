@@ -481,6 +481,152 @@ static inline std::vector<IntersectionLines> slice_make_lines(
     return lines;
 }
 
+// Facets crossing each slicing plane in a compressed sparse row format:
+// indices of facets crossing zs[layer_id] are stored in facets[layer_begin[layer_id] .. layer_begin[layer_id + 1]).
+struct FacetsAtLayers
+{
+    std::vector<size_t> layer_begin;
+    std::vector<int>    facets;
+};
+
+// Index the facets by the span of slicing planes they cross, so that slicing of a single layer only touches the facets crossing it.
+// Horizontal facets are not indexed, they are ignored by slicing.
+// Facets of a single layer are sorted by their index, thus the index does not depend on scheduling of the worker threads.
+template<typename ThrowOnCancel>
+static FacetsAtLayers facets_at_layers(
+    // Z coordinates of the mesh vertices, stored separately from XY to make the Z extents of the facets cheap to calculate.
+    const std::vector<float>                        &vertices_z,
+    const std::vector<stl_triangle_vertex_indices>  &indices,
+    const std::vector<float>                        &zs,
+    const ThrowOnCancel                              throw_on_cancel_fn)
+{
+    const size_t num_facets = indices.size();
+    const size_t num_layers = zs.size();
+    // Facets are processed in a fixed number of chunks. Each chunk counts its facets crossing each layer,
+    // the counts are then turned into the chunk's output offsets per layer and the chunks fill in the index in parallel.
+    const size_t num_chunks = std::clamp<size_t>(num_facets / 65536, 1, 64);
+    auto         chunk_range = [num_facets, num_chunks](size_t chunk_id) {
+        return std::make_pair(num_facets * chunk_id / num_chunks, num_facets * (chunk_id + 1) / num_chunks);
+    };
+    // Span of layers [first, second) crossed by a facet.
+    std::vector<std::pair<int, int>> facet_layers(num_facets);
+    std::vector<size_t>              chunk_offsets(num_chunks * num_layers, 0);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+        [&vertices_z, &indices, &zs, num_layers, &chunk_range, &facet_layers, &chunk_offsets, throw_on_cancel_fn](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_id = range.begin(); chunk_id < range.end(); ++ chunk_id) {
+                auto [chunk_begin, chunk_end] = chunk_range(chunk_id);
+                size_t *counts = chunk_offsets.data() + chunk_id * num_layers;
+                // Z extents of the facets are calculated over blocks laid out as structure of arrays, which the compiler vectorizes.
+                static constexpr const size_t block_size = 256;
+                float z0[block_size], z1[block_size], z2[block_size], min_z[block_size], max_z[block_size];
+                for (size_t block_begin = chunk_begin; block_begin < chunk_end; block_begin += block_size) {
+                    if (((block_begin - chunk_begin) & 0x0ffff) == 0)
+                        throw_on_cancel_fn();
+                    const size_t n = std::min(block_size, chunk_end - block_begin);
+                    for (size_t i = 0; i < n; ++ i) {
+                        const stl_triangle_vertex_indices &face = indices[block_begin + i];
+                        z0[i] = vertices_z[face(0)];
+                        z1[i] = vertices_z[face(1)];
+                        z2[i] = vertices_z[face(2)];
+                    }
+                    for (size_t i = 0; i < n; ++ i) {
+                        min_z[i] = std::min(z0[i], std::min(z1[i], z2[i]));
+                        max_z[i] = std::max(z0[i], std::max(z1[i], z2[i]));
+                    }
+                    for (size_t i = 0; i < n; ++ i) {
+                        std::pair<int, int> &span = facet_layers[block_begin + i];
+                        if (min_z[i] == max_z[i]) {
+                            // Ignore horizontal triangles. Any valid horizontal triangle must have a vertical triangle connected, otherwise the part has zero volume.
+                            span = { 0, 0 };
+                            continue;
+                        }
+                        auto min_layer = std::lower_bound(zs.begin(), zs.end(), min_z[i]); // first layer whose slice_z is >= min_z
+                        auto max_layer = std::upper_bound(min_layer, zs.end(), max_z[i]); // first layer whose slice_z is > max_z
+                        span = { int(min_layer - zs.begin()), int(max_layer - zs.begin()) };
+                        for (int layer_id = span.first; layer_id < span.second; ++ layer_id)
+                            ++ counts[layer_id];
+                    }
+                }
+            }
+        });
+
+    FacetsAtLayers out;
+    out.layer_begin.assign(num_layers + 1, 0);
+    size_t offset = 0;
+    for (size_t layer_id = 0; layer_id < num_layers; ++ layer_id) {
+        out.layer_begin[layer_id] = offset;
+        for (size_t chunk_id = 0; chunk_id < num_chunks; ++ chunk_id) {
+            size_t &chunk_offset = chunk_offsets[chunk_id * num_layers + layer_id];
+            size_t  count        = chunk_offset;
+            chunk_offset = offset;
+            offset      += count;
+        }
+    }
+    out.layer_begin.back() = offset;
+    out.facets.assign(offset, -1);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+        [num_layers, &chunk_range, &facet_layers, &chunk_offsets, &out](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_id = range.begin(); chunk_id < range.end(); ++ chunk_id) {
+                auto [chunk_begin, chunk_end] = chunk_range(chunk_id);
+                size_t *offsets = chunk_offsets.data() + chunk_id * num_layers;
+                for (size_t face_idx = chunk_begin; face_idx < chunk_end; ++ face_idx)
+                    for (int layer_id = facet_layers[face_idx].first; layer_id < facet_layers[face_idx].second; ++ layer_id)
+                        out.facets[offsets[layer_id] ++] = int(face_idx);
+            }
+        });
+
+    return out;
+}
+
+// Slice the facets layer by layer using facets_at_layers() index. In contrast to the slice_make_lines() variant iterating over facets,
+// each layer only visits the facets crossing it and it fills in its own lines, thus the layers are sliced in parallel without locking.
+template<AdditionalMeshInfo mesh_info, typename ThrowOnCancel>
+static inline std::vector<IntersectionLines> slice_make_lines_indexed(
+    // Vertices scaled in XY, unscaled in Z, already transformed.
+    const std::vector<stl_vertex>                   &vertices,
+    const std::vector<stl_triangle_vertex_indices>  &indices,
+    const std::vector<Vec3i>                        &face_edge_ids,
+    const FacetColorFunctor<mesh_info>              &facet_color_fn,
+    const std::vector<float>                        &zs,
+    const ThrowOnCancel                              throw_on_cancel_fn)
+{
+    std::vector<float> vertices_z(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++ i)
+        vertices_z[i] = vertices[i].z();
+    const FacetsAtLayers facets = facets_at_layers(vertices_z, indices, zs, throw_on_cancel_fn);
+    vertices_z = {};
+    throw_on_cancel_fn();
+
+    std::vector<IntersectionLines> lines(zs.size(), IntersectionLines{});
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, zs.size()),
+        [&vertices, &indices, &face_edge_ids, &facet_color_fn, &zs, &facets, &lines, throw_on_cancel_fn](const tbb::blocked_range<size_t> &range) {
+            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+                throw_on_cancel_fn();
+                const float        slice_z     = zs[layer_id];
+                IntersectionLines &layer_lines = lines[layer_id];
+                layer_lines.reserve(facets.layer_begin[layer_id + 1] - facets.layer_begin[layer_id]);
+                for (size_t i = facets.layer_begin[layer_id]; i < facets.layer_begin[layer_id + 1]; ++ i) {
+                    const int                          face_idx = facets.facets[i];
+                    const stl_triangle_vertex_indices &face     = indices[face_idx];
+                    const stl_vertex                   face_vertices[3] { vertices[face(0)], vertices[face(1)], vertices[face(2)] };
+                    const float min_z = fminf(face_vertices[0].z(), fminf(face_vertices[1].z(), face_vertices[2].z()));
+                    int idx_vertex_lowest = (face_vertices[1].z() == min_z) ? 1 : ((face_vertices[2].z() == min_z) ? 2 : 0);
+                    IntersectionLine il;
+                    if (slice_facet(slice_z, face_vertices, face, face_edge_ids[face_idx], idx_vertex_lowest, false, facet_color_fn(face_idx), il) == FacetSliceType::Slicing) {
+                        assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
+                        layer_lines.emplace_back(il);
+                    }
+                }
+            }
+        }
+    );
+
+    return lines;
+}
+
 template<AdditionalMeshInfo mesh_info, typename TransformVertex, typename FaceFilter>
 static inline IntersectionLines slice_make_lines(
     const std::vector<stl_vertex>                   &mesh_vertices,
@@ -1970,9 +2116,10 @@ std::vector<typename PolygonsType<mesh_info>::type> slice_mesh(
             }
         } else {
             // Copy and scale vertices in XY, don't scale in Z. Possibly apply the transformation.
-            lines = slice_make_lines(
+            // Then slice layer by layer, each layer visiting just the facets crossing it.
+            lines = slice_make_lines_indexed(
                 transform_mesh_vertices_for_slicing<mesh_info>(mesh, params.trafo),
-                [](const Vec3f &p) { return p; },  mesh.indices, face_edge_ids, facet_color_fn, zs, throw_on_cancel);
+                mesh.indices, face_edge_ids, facet_color_fn, zs, throw_on_cancel);
         }
     }
 
@@ -0,0 +1,142 @@
+#include "VolumeSlicesCache.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "libslic3r/TriangleMesh.hpp"
+
+namespace Slic3r {
+
+bool VolumeSlicesCache::Key::operator==(const Key &rhs) const
+{
+    return this->mesh == rhs.mesh && this->trafo.matrix() == rhs.trafo.matrix() &&
+           this->closing_radius == rhs.closing_radius && this->extra_offset == rhs.extra_offset && this->resolution == rhs.resolution;
+}
+
+static size_t expolygons_memory_used(const ExPolygons &expolygons)
+{
+    size_t out = expolygons.capacity() * sizeof(ExPolygon);
+    for (const ExPolygon &expoly : expolygons) {
+        out += expoly.contour.points.capacity() * sizeof(Point) + expoly.holes.capacity() * sizeof(Polygon);
+        for (const Polygon &hole : expoly.holes)
+            out += hole.points.capacity() * sizeof(Point);
+    }
+    return out;
+}
+
+std::vector<ExPolygons> VolumeSlicesCache::slice(
+    const std::shared_ptr<const TriangleMesh> &mesh,
+    const std::vector<float>                  &zs,
+    const MeshSlicingParamsEx                 &params,
+    const std::function<void()>               &throw_on_cancel_callback)
+{
+    if (zs.empty() || mesh->its.indices.empty())
+        return {};
+
+    std::vector<ExPolygons> out(zs.size());
+    const Key key { mesh, params.trafo, params.closing_radius, params.extra_offset, params.resolution };
+    auto slicing_mode = [&params](size_t layer_id) {
+        return layer_id < params.slicing_mode_normal_below_layer ? params.mode_below : params.mode;
+    };
+
+    // Indices of zs, which were not found in the cache.
+    std::vector<size_t> missing;
+    {
+        std::scoped_lock<std::mutex> lock(m_mutex);
+        auto it_entry = std::find_if(m_entries.begin(), m_entries.end(), [&key](const Entry &entry) { return entry.key == key; });
+        for (size_t i = 0; i < zs.size(); ++ i) {
+            if (it_entry != m_entries.end()) {
+                if (auto it = it_entry->slices.find(std::make_pair(zs[i], slicing_mode(i))); it != it_entry->slices.end()) {
+                    out[i] = it->second;
+                    continue;
+                }
+            }
+            missing.emplace_back(i);
+        }
+    }
+
+    if (! missing.empty()) {
+        std::vector<float>  zs_missing;
+        MeshSlicingParamsEx params_missing { params };
+        zs_missing.reserve(missing.size());
+        params_missing.slicing_mode_normal_below_layer = 0;
+        for (size_t i : missing) {
+            zs_missing.emplace_back(zs[i]);
+            if (i < params.slicing_mode_normal_below_layer)
+                // zs are sorted, thus the planes sliced with mode_below form a prefix of zs_missing.
+                ++ params_missing.slicing_mode_normal_below_layer;
+        }
+        std::vector<ExPolygons> layers;
+        if (params.trafo.rotation().determinant() < 0.) {
+            indexed_triangle_set its = mesh->its;
+            its_flip_triangles(its);
+            layers = slice_mesh_ex(its, zs_missing, params_missing, throw_on_cancel_callback);
+        } else
+            layers = slice_mesh_ex(mesh->its, zs_missing, params_missing, throw_on_cancel_callback);
+        throw_on_cancel_callback();
+        assert(layers.size() == missing.size());
+        for (size_t i = 0; i < missing.size(); ++ i)
+            out[missing[i]] = std::move(layers[i]);
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock(m_mutex);
+        auto it_entry = std::find_if(m_entries.begin(), m_entries.end(), [&key](const Entry &entry) { return entry.key == key; });
+        if (it_entry == m_entries.end()) {
+            m_entries.push_back({ key });
+            it_entry = std::prev(m_entries.end());
+        }
+        Entry &entry = *it_entry;
+        // Keep just the slicing planes used by the last query, slicing planes of an old layer height profile are not likely to be reused.
+        m_memory_used -= entry.memory_used;
+        entry.slices.clear();
+        entry.memory_used = 0;
+        for (size_t i = 0; i < zs.size(); ++ i) {
+            entry.memory_used += expolygons_memory_used(out[i]);
+            entry.slices.emplace(std::make_pair(zs[i], slicing_mode(i)), out[i]);
+        }
+        entry.last_used = ++ m_timestamp;
+        m_memory_used += entry.memory_used;
+        this->evict();
+    }
+
+    return out;
+}
+
+void VolumeSlicesCache::evict()
+{
+    // Meshes, which are referenced by the cache only, were removed from the model.
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+        if (it->key.mesh.use_count() == 1) {
+            m_memory_used -= it->memory_used;
+            it = m_entries.erase(it);
+        } else
+            ++ it;
+    while (m_memory_used > m_memory_limit && ! m_entries.empty()) {
+        auto it = std::min_element(m_entries.begin(), m_entries.end(), [](const Entry &l, const Entry &r) { return l.last_used < r.last_used; });
+        m_memory_used -= it->memory_used;
+        m_entries.erase(it);
+    }
+}
+
+void VolumeSlicesCache::clear()
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_memory_used = 0;
+}
+
+size_t VolumeSlicesCache::memory_used() const
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    return m_memory_used;
+}
+
+void VolumeSlicesCache::set_memory_limit(size_t limit)
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_memory_limit = limit;
+    this->evict();
+}
+
+} // namespace Slic3r
@@ -0,0 +1,77 @@
+#ifndef slic3r_VolumeSlicesCache_hpp_
+#define slic3r_VolumeSlicesCache_hpp_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "libslic3r/ExPolygon.hpp"
+#include "libslic3r/Point.hpp"
+#include "libslic3r/TriangleMeshSlicer.hpp"
+
+namespace Slic3r {
+
+class TriangleMesh;
+
+// Cache of slices of triangle meshes produced by PrintObject::slice_volumes().
+// The cache is owned by Print, thus it survives the PrintObjects being invalidated and recreated by Print::apply()
+// after a modifier is added or after the layer height profile changes.
+// Slices are cached per slicing plane, keyed by the mesh, its transformation, the slicing parameters
+// and the Z of the slicing plane, thus only the slicing planes not seen before are sliced again.
+// Thread safe, PrintObjects are sliced in parallel.
+class VolumeSlicesCache
+{
+public:
+    // Slice the mesh the same way slice_mesh_ex() does, including flipping of the triangles
+    // for a mirroring transformation. Reuse the slices cached for the same mesh, transformation, slicing parameters and Z.
+    std::vector<ExPolygons> slice(
+        const std::shared_ptr<const TriangleMesh> &mesh,
+        const std::vector<float>                  &zs,
+        const MeshSlicingParamsEx                 &params,
+        const std::function<void()>               &throw_on_cancel_callback);
+
+    void                    clear();
+    // Approximate memory occupied by the cached slices.
+    size_t                  memory_used() const;
+    // The least recently used meshes are dropped from the cache once the cached slices occupy more memory than the limit.
+    void                    set_memory_limit(size_t limit);
+
+private:
+    struct Key {
+        // Meshes shared by ModelVolumes are immutable, thus the identity of the shared mesh is used as a hash of its content.
+        // Holding the pointer keeps the mesh alive, thus its address cannot be reused by another mesh.
+        std::shared_ptr<const TriangleMesh> mesh;
+        Transform3d                         trafo;
+        float                               closing_radius;
+        float                               extra_offset;
+        double                              resolution;
+
+        bool operator==(const Key &rhs) const;
+    };
+
+    struct Entry {
+        Key                                                                     key;
+        // Slices of a single plane keyed by Z of the plane and the slicing mode applied to that plane.
+        std::map<std::pair<float, MeshSlicingParams::SlicingMode>, ExPolygons> slices;
+        size_t                                                                  memory_used { 0 };
+        size_t                                                                  last_used { 0 };
+    };
+
+    // Drop entries of meshes, which are not referenced by any ModelVolume anymore,
+    // and the least recently used entries above the memory limit.
+    void                    evict();
+
+    mutable std::mutex      m_mutex;
+    std::vector<Entry>      m_entries;
+    size_t                  m_memory_used  { 0 };
+    size_t                  m_memory_limit { size_t(512) * 1024 * 1024 };
+    size_t                  m_timestamp    { 0 };
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_VolumeSlicesCache_hpp_
@@ -3,6 +3,12 @@
 ///|/ PrusaSlicer is released under the terms of the AGPLv3 or higher
 ///|/
 #include <cstdio>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+
+#include <tbb/parallel_for.h>
 
 #include "miniz_extension.hpp"
 #include "miniz.h"
@@ -66,6 +72,195 @@ bool close_zip(mz_zip_archive *zip, bool isread)
     }
     return ret;
 }
+
+// Blocks of the parallel deflate. Each block restarts the dictionary, thus the blocks have to be large
+// enough not to degrade the compression ratio, and small enough to split a single PNG raster.
+constexpr size_t DEFLATE_BLOCK_SIZE = 512 * 1024;
+
+mz_bool put_into_vector(const void *buf, int len, void *user)
+{
+    auto &out = *static_cast<std::vector<mz_uint8>*>(user);
+    const auto *data = static_cast<const mz_uint8*>(buf);
+    out.insert(out.end(), data, data + len);
+    return MZ_TRUE;
+}
+
+// Combining the checksums of two consecutive buffers, see crc32_combine() and adler32_combine() of zlib.
+mz_uint32 crc32_multmodp(mz_uint32 a, mz_uint32 b)
+{
+    mz_uint32 m = mz_uint32(1) << 31;
+    mz_uint32 p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0)
+                break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ 0xedb88320 : b >> 1;
+    }
+    return p;
+}
+
+mz_uint32 crc32_combine(mz_uint32 crc1, mz_uint32 crc2, size_t len2)
+{
+    // x^(2^k) modulo the CRC polynomial for k = 0..63.
+    static const auto x2n_table = []() {
+        std::array<mz_uint32, 64> table;
+        mz_uint32 p = mz_uint32(1) << 30;
+        for (mz_uint32 &t : table) {
+            t = p;
+            p = crc32_multmodp(p, p);
+        }
+        return table;
+    }();
+    // Multiply crc1 by x^(8 * len2).
+    mz_uint32 p = mz_uint32(1) << 31;
+    for (size_t n = len2, k = 3; n; n >>= 1, ++ k)
+        if (n & 1)
+            p = crc32_multmodp(x2n_table[k & 63], p);
+    return crc32_multmodp(p, crc1) ^ crc2;
+}
+
+mz_uint32 adler32_combine(mz_uint32 adler1, mz_uint32 adler2, size_t len2)
+{
+    constexpr mz_uint32 base = 65521;
+    const mz_uint32 rem  = mz_uint32(len2 % base);
+    mz_uint32       sum1 = adler1 & 0xffff;
+    mz_uint32       sum2 = mz_uint32((mz_uint64(rem) * sum1) % base);
+    sum1 += (adler2 & 0xffff) + base - 1;
+    sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) + base - rem;
+    if (sum1 >= base) sum1 -= base;
+    if (sum1 >= base) sum1 -= base;
+    if (sum2 >= (base << 1)) sum2 -= (base << 1);
+    if (sum2 >= base) sum2 -= base;
+    return sum1 | (sum2 << 16);
+}
+
+// Compress num_blocks blocks in parallel into a single raw deflate stream.
+// feed(block_idx, put) passes the uncompressed data of a block by calling put(data, size) one or more times.
+template<typename FeedFn>
+bool deflate_blocks_parallel(size_t num_blocks, mz_uint level, FeedFn &&feed, std::vector<mz_uint8> &out,
+                             mz_uint32 *crc_out, mz_uint32 *adler_out)
+{
+    struct Block {
+        std::vector<mz_uint8> data;
+        size_t                size    { 0 };
+        mz_uint32             crc     { MZ_CRC32_INIT };
+        mz_uint32             adler   { MZ_ADLER32_INIT };
+        bool                  ok      { false };
+    };
+    std::vector<Block> blocks(num_blocks);
+    const mz_uint flags = tdefl_create_comp_flags_from_zip_params(int(level), -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks, 1), [&](const tbb::blocked_range<size_t> &range) {
+        tdefl_compressor *comp = tdefl_compressor_alloc();
+        if (comp == nullptr)
+            return;
+        for (size_t block_idx = range.begin(); block_idx < range.end(); ++ block_idx) {
+            Block &block = blocks[block_idx];
+            block.ok = tdefl_init(comp, put_into_vector, &block.data, flags) == TDEFL_STATUS_OKAY;
+            feed(block_idx, [&block, comp, crc_out, adler_out](const mz_uint8 *data, size_t size) {
+                if (block.ok && size > 0) {
+                    block.ok = tdefl_compress_buffer(comp, data, size, TDEFL_NO_FLUSH) == TDEFL_STATUS_OKAY;
+                    block.size += size;
+                    if (crc_out)
+                        block.crc = mz_uint32(mz_crc32(block.crc, data, size));
+                    if (adler_out)
+                        block.adler = mz_uint32(mz_adler32(block.adler, data, size));
+                }
+            });
+            // Only the last block is final, the others are byte aligned by an empty stored block.
+            if (block.ok)
+                block.ok = block_idx + 1 == num_blocks ?
+                    tdefl_compress_buffer(comp, nullptr, 0, TDEFL_FINISH) == TDEFL_STATUS_DONE :
+                    tdefl_compress_buffer(comp, nullptr, 0, TDEFL_SYNC_FLUSH) == TDEFL_STATUS_OKAY;
+        }
+        tdefl_compressor_free(comp);
+    });
+
+    size_t out_size = out.size();
+    for (const Block &block : blocks)
+        out_size += block.data.size();
+    out.reserve(out_size);
+    mz_uint32 crc   = MZ_CRC32_INIT;
+    mz_uint32 adler = MZ_ADLER32_INIT;
+    for (const Block &block : blocks) {
+        if (! block.ok)
+            return false;
+        out.insert(out.end(), block.data.begin(), block.data.end());
+        crc   = crc32_combine(crc, block.crc, block.size);
+        adler = adler32_combine(adler, block.adler, block.size);
+    }
+    if (crc_out)
+        *crc_out = crc;
+    if (adler_out)
+        *adler_out = adler;
+    return true;
+}
+
+// Write a PNG with the image rows compressed in parallel.
+// row(y, buffer, bpl) returns the bpl bytes of row y, it may use the buffer to store them.
+template<typename RowFn>
+void *write_png_parallel(int w, int h, int num_chans, size_t *len_out, mz_uint level, RowFn &&row)
+{
+    *len_out = 0;
+    const size_t bpl = size_t(w) * size_t(num_chans);
+    if (w <= 0 || h <= 0 || num_chans < 1 || num_chans > 4)
+        return nullptr;
+
+    // Image rows prefixed with the "none" filter byte, split into blocks of whole rows.
+    const size_t rows_per_block = std::max<size_t>(1, DEFLATE_BLOCK_SIZE / (bpl + 1));
+    const size_t num_blocks     = (size_t(h) + rows_per_block - 1) / rows_per_block;
+
+    // PNG signature, IHDR chunk, IDAT chunk header and the zlib header of the compressed stream.
+    static const mz_uint8 chans[] = { 0x00, 0x00, 0x04, 0x02, 0x06 };
+    std::vector<mz_uint8> png = {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a,
+        0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+        mz_uint8(w >> 24), mz_uint8(w >> 16), mz_uint8(w >> 8), mz_uint8(w),
+        mz_uint8(h >> 24), mz_uint8(h >> 16), mz_uint8(h >> 8), mz_uint8(h),
+        0x08, chans[num_chans], 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x49, 0x44, 0x41, 0x54,
+        0x78, 0x01 };
+    auto write_be32 = [](mz_uint8 *dst, mz_uint32 v) {
+        for (int i = 0; i < 4; ++ i, v <<= 8)
+            dst[i] = mz_uint8(v >> 24);
+    };
+    write_be32(png.data() + 29, mz_uint32(mz_crc32(MZ_CRC32_INIT, png.data() + 12, 17)));
+    const size_t idat_begin = png.size() - 2;
+
+    mz_uint32 adler = MZ_ADLER32_INIT;
+    if (! deflate_blocks_parallel(num_blocks, level,
+            [&row, h, bpl, rows_per_block](size_t block_idx, auto &&put) {
+                static const mz_uint8 filter = 0;
+                std::vector<mz_uint8> buffer;
+                const size_t first = block_idx * rows_per_block;
+                const size_t last  = std::min(first + rows_per_block, size_t(h));
+                for (size_t y = first; y < last; ++ y) {
+                    put(&filter, 1);
+                    put(row(y, buffer, bpl), bpl);
+                }
+            }, png, nullptr, &adler))
+        return nullptr;
+
+    // Adler-32 of the zlib stream, CRC-32 of the IDAT chunk and the IEND chunk.
+    png.resize(png.size() + 4);
+    write_be32(png.data() + png.size() - 4, adler);
+    const size_t idat_size = png.size() - idat_begin;
+    write_be32(png.data() + idat_begin - 8, mz_uint32(idat_size));
+    png.resize(png.size() + 4);
+    write_be32(png.data() + png.size() - 4, mz_uint32(mz_crc32(MZ_CRC32_INIT, png.data() + idat_begin - 4, idat_size + 4)));
+    static const mz_uint8 iend[] = { 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82 };
+    png.insert(png.end(), std::begin(iend), std::end(iend));
+
+    void *out = MZ_MALLOC(png.size());
+    if (out == nullptr)
+        return nullptr;
+    memcpy(out, png.data(), png.size());
+    *len_out = png.size();
+    return out;
+}
 }
 
 bool open_zip_reader(mz_zip_archive *zip, const std::string &fname)
@@ -81,6 +276,58 @@ bool open_zip_writer(mz_zip_archive *zip, const std::string &fname)
 bool close_zip_reader(mz_zip_archive *zip) { return close_zip(zip, true); }
 bool close_zip_writer(mz_zip_archive *zip) { return close_zip(zip, false); }
 
+bool deflate_parallel(const void *data, size_t size, mz_uint level, std::vector<mz_uint8> &out,
+                      mz_uint32 *crc_out, mz_uint32 *adler_out)
+{
+    const size_t num_blocks = std::max<size_t>(1, (size + DEFLATE_BLOCK_SIZE - 1) / DEFLATE_BLOCK_SIZE);
+    return deflate_blocks_parallel(num_blocks, level,
+        [data, size](size_t block_idx, auto &&put) {
+            const size_t begin = block_idx * DEFLATE_BLOCK_SIZE;
+            put(static_cast<const mz_uint8*>(data) + begin, std::min(size - begin, DEFLATE_BLOCK_SIZE));
+        }, out, crc_out, adler_out);
+}
+
+bool zip_writer_add_mem_parallel(mz_zip_archive *zip, const char *name, const void *data, size_t size, mz_uint level)
+{
+    // Not worth splitting, let miniz compress the buffer on this thread.
+    if (level == MZ_NO_COMPRESSION || size < 2 * DEFLATE_BLOCK_SIZE)
+        return mz_zip_writer_add_mem(zip, name, data, size, level);
+
+    std::vector<mz_uint8> compressed;
+    mz_uint32             crc = MZ_CRC32_INIT;
+    if (! deflate_parallel(data, size, level, compressed, &crc, nullptr)) {
+        zip->m_last_error = MZ_ZIP_COMPRESSION_FAILED;
+        return false;
+    }
+    return mz_zip_writer_add_mem_ex(zip, name, compressed.data(), compressed.size(), nullptr, 0,
+                                    level | MZ_ZIP_FLAG_COMPRESSED_DATA, size, crc);
+}
+
+void *write_image_to_png_file_in_memory_parallel(const void *image, int w, int h, int num_chans,
+                                                 size_t *len_out, mz_uint level, bool flip)
+{
+    // Small images are not worth splitting.
+    if ((size_t(w) * size_t(num_chans) + 1) * size_t(h) < 2 * DEFLATE_BLOCK_SIZE)
+        return tdefl_write_image_to_png_file_in_memory_ex(image, w, h, num_chans, len_out, level, flip);
+
+    return write_png_parallel(w, h, num_chans, len_out, level,
+        [image, h, flip](size_t y, std::vector<mz_uint8> &, size_t bpl) {
+            return static_cast<const mz_uint8*>(image) + (flip ? size_t(h) - 1 - y : y) * bpl;
+        });
+}
+
+void *write_png_rows_to_memory_parallel(int w, int h, int num_chans,
+                                        const std::function<void(size_t row, mz_uint8 *out)> &read_row,
+                                        size_t *len_out, mz_uint level)
+{
+    return write_png_parallel(w, h, num_chans, len_out, level,
+        [&read_row](size_t y, std::vector<mz_uint8> &buffer, size_t bpl) {
+            buffer.resize(bpl);
+            read_row(y, buffer.data());
+            return static_cast<const mz_uint8*>(buffer.data());
+        });
+}
+
 MZ_Archive::MZ_Archive()
 {
     mz_zip_zero_struct(&arch);
@@ -6,6 +6,8 @@
 #define MINIZ_EXTENSION_HPP
 
 #include <string>
+#include <vector>
+#include <functional>
 #include <miniz.h>
 
 namespace Slic3r {
@@ -15,6 +17,27 @@ bool open_zip_writer(mz_zip_archive *zip, const std::string &fname_utf8);
 bool close_zip_reader(mz_zip_archive *zip);
 bool close_zip_writer(mz_zip_archive *zip);
 
+// Compress data into a raw deflate stream (no zlib header) using all cores. Like pigz does, the data
+// is split into blocks compressed independently, each block ending with a sync flush, so that
+// the concatenated blocks form a single valid deflate stream. Small inputs are compressed
+// by a single block. CRC-32 and Adler-32 of the uncompressed data are returned if requested.
+bool deflate_parallel(const void *data, size_t size, mz_uint level, std::vector<mz_uint8> &out,
+                      mz_uint32 *crc_out = nullptr, mz_uint32 *adler_out = nullptr);
+
+// Add a memory buffer to the archive. Large buffers are compressed in parallel by deflate_parallel().
+bool zip_writer_add_mem_parallel(mz_zip_archive *zip, const char *name, const void *data, size_t size, mz_uint level);
+
+// Parallel counterpart of tdefl_write_image_to_png_file_in_memory_ex(), producing an equivalent PNG.
+// The returned buffer is to be released with mz_free().
+void *write_image_to_png_file_in_memory_parallel(const void *image, int w, int h, int num_chans,
+                                                 size_t *len_out, mz_uint level, bool flip);
+
+// PNG of an image, which is not stored in memory as a whole. read_row(row, out) writes w * num_chans bytes
+// of the row into out, it is called from multiple threads.
+void *write_png_rows_to_memory_parallel(int w, int h, int num_chans,
+                                        const std::function<void(size_t row, mz_uint8 *out)> &read_row,
+                                        size_t *len_out, mz_uint level);
+
 class MZ_Archive {
 public:
     mz_zip_archive arch;
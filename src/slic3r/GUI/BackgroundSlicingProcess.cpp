@@ -253,6 +253,10 @@ void BackgroundSlicingProcess::thread_proc()
 		// Process the background slicing task.
 		m_state = STATE_RUNNING;
 		lck.unlock();
+		// Profile the steps executed by this task if requested by --profile-trace, see PrintBase::profiler().
+		const std::string &profile_trace = GUI::wxGetApp().init_params->profile_trace;
+		m_print->profiler().clear();
+		m_print->profiler().enable(! profile_trace.empty());
 		std::exception_ptr exception;
 #ifdef _WIN32
 		this->call_process_seh_throw(exception);
@@ -260,6 +264,13 @@ void BackgroundSlicingProcess::thread_proc()
 		this->call_process(exception);
 #endif
 		m_print->finalize();
+		if (! profile_trace.empty() && ! exception && ! m_print->canceled()) {
+			try {
+				m_print->profiler().export_chrome_trace(profile_trace);
+			} catch (const std::exception &ex) {
+				BOOST_LOG_TRIVIAL(error) << ex.what();
+			}
+		}
 		lck.lock();
 		m_state = m_print->canceled() ? STATE_CANCELED : STATE_FINISHED;
 		if (m_print->cancel_status() != Print::CANCELED_INTERNAL) {
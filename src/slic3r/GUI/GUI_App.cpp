@@ -66,6 +66,7 @@
 #include "libslic3r/Color.hpp"
 #include "libslic3r/Format/SLAArchiveFormatRegistry.hpp"
 #include "libslic3r/Utils/DirectoriesUtils.hpp"
+#include "libslic3r/Support/TreeModelVolumes.hpp"
 
 #include "GUI.hpp"
 #include "GUI_Utils.hpp"
@@ -981,6 +982,13 @@ void copy_vendor_ini(const std::vector<std::string>& vendors)
         }
     }
 }
+
+// The disk cache of organic support volumes is opt-in, see the "tree_support_disk_cache" preference.
+void update_tree_support_disk_cache(const AppConfig &app_config)
+{
+    FFFTreeSupport::TreeModelVolumes::set_disk_cache_directory(app_config.get_bool("tree_support_disk_cache") ?
+        FFFTreeSupport::TreeModelVolumes::default_disk_cache_directory() : std::string());
+}
 }
 
 void GUI_App::legacy_app_config_vendor_check()
@@ -1567,6 +1575,7 @@ bool GUI_App::on_init_inner()
     std::string delayed_error_load_presets;
     // Suppress the '- default -' presets.
     preset_bundle->set_default_suppressed(app_config->get_bool("no_defaults"));
+    update_tree_support_disk_cache(*app_config);
     try {
         // Enable all substitutions (in both user and system profiles), but log the substitutions in user profiles only.
         // If there are substitutions in system profiles, then a "reconfigure" event shall be triggered, which will force
@@ -2878,6 +2887,9 @@ void GUI_App::open_preferences(const std::string& highlight_option /*= std::stri
     if (mainframe->preferences_dialog->seq_top_layer_only_changed())
         this->plater_->reload_print();
 
+    if (is_editor())
+        update_tree_support_disk_cache(*app_config);
+
 #ifdef _WIN32
     if (is_editor()) {
         if (app_config->get_bool("associate_3mf"))
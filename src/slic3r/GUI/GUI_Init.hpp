@@ -43,6 +43,8 @@ struct GUI_InitParams
     bool                        start_downloader                { false };
     bool                        delete_after_load               { false };
     std::string                 download_url;
+    // If not empty, the steps of the background processing are profiled and saved to this file as Chrome trace JSON.
+    std::string                 profile_trace;
 #if !SLIC3R_OPENGL_ES
     std::pair<int, int>         opengl_version                  { 0, 0 };
     bool                        opengl_debug                    { false };
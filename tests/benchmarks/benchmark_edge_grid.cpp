@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <random>
+#include <vector>
+
+#include "libslic3r/libslic3r.h"
+#include "libslic3r/EdgeGrid.hpp"
+#include "libslic3r/Layer.hpp"
+#include "libslic3r/Print.hpp"
+#include "libslic3r/PrintConfig.hpp"
+
+#include "test_data.hpp"
+#include "test_utils.hpp"
+
+using namespace Slic3r;
+using namespace Slic3r::Test;
+
+namespace {
+
+// Slices of all the layers of a model, the input of the EdgeGrid queries of the perimeter, fill and seam code.
+std::vector<ExPolygons> layer_slices(const TriangleMesh &mesh)
+{
+    Print print;
+    Model model;
+    DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+    config.set_deserialize_strict({ { "layer_height", 0.2 } });
+    init_print({ mesh }, print, model, config);
+    PrintBase::TaskParams params;
+    params.to_object_step = posSlice;
+    print.set_task(params);
+    print.process();
+    std::vector<ExPolygons> out;
+    for (const Layer *layer : print.objects().front()->layers())
+        out.emplace_back(layer->lslices);
+    return out;
+}
+
+// Random points inside the bounding box of each layer, fixed seed to make the results comparable.
+std::vector<Points> sample_points(const std::vector<ExPolygons> &layers, size_t num_points_per_layer)
+{
+    std::mt19937 rng(0);
+    std::vector<Points> out;
+    for (const ExPolygons &expolygons : layers) {
+        const BoundingBox bbox = get_extents(expolygons);
+        std::uniform_int_distribution<coord_t> dist_x(bbox.min.x(), bbox.max.x()), dist_y(bbox.min.y(), bbox.max.y());
+        Points pts;
+        for (size_t i = 0; i < num_points_per_layer; ++ i)
+            pts.emplace_back(dist_x(rng), dist_y(rng));
+        out.emplace_back(std::move(pts));
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("EdgeGrid", "[Benchmarks][EdgeGrid]") {
+    for (const char *model_name : { "extruder_idler.obj", "frog_legs.obj" }) {
+        const std::vector<ExPolygons> layers = layer_slices(load_model(model_name));
+        const std::vector<Points>     points = sample_points(layers, 1000);
+        // Resolution and search radius of the grids of the perimeter generator and of the seam placer.
+        const coord_t resolution    = scaled<coord_t>(1.);
+        const coord_t search_radius = scaled<coord_t>(0.5);
+
+        BENCHMARK(std::string("EdgeGrid create ") + model_name) {
+            size_t num_cells = 0;
+            for (const ExPolygons &expolygons : layers) {
+                EdgeGrid::Grid grid;
+                grid.create(expolygons, resolution);
+                num_cells += grid.rows() * grid.cols();
+            }
+            return num_cells;
+        };
+
+        std::vector<EdgeGrid::Grid> grids(layers.size());
+        for (size_t i = 0; i < layers.size(); ++ i)
+            grids[i].create(layers[i], resolution);
+
+        BENCHMARK(std::string("EdgeGrid closest_point_signed_distance ") + model_name) {
+            double sum = 0.;
+            for (size_t i = 0; i < grids.size(); ++ i)
+                for (const Point &pt : points[i])
+                    if (EdgeGrid::Grid::ClosestPointResult result = grids[i].closest_point_signed_distance(pt, search_radius); result.valid())
+                        sum += result.distance;
+            return sum;
+        };
+
+        BENCHMARK(std::string("EdgeGrid signed_distance_edges ") + model_name) {
+            double sum = 0.;
+            for (size_t i = 0; i < grids.size(); ++ i)
+                for (const Point &pt : points[i])
+                    if (coordf_t distance; grids[i].signed_distance_edges(pt, search_radius, distance))
+                        sum += distance;
+            return sum;
+        };
+    }
+}
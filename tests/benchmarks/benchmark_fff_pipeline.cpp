@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include "libslic3r/libslic3r.h"
+#include "libslic3r/Print.hpp"
+#include "libslic3r/PrintConfig.hpp"
+#include "libslic3r/TriangleMesh.hpp"
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+
+#include "test_data.hpp"
+#include "test_utils.hpp"
+
+using namespace Slic3r;
+using namespace Slic3r::Test;
+
+namespace {
+
+struct BenchmarkModel
+{
+    std::string     name;
+    TriangleMesh    mesh;
+};
+
+// Models of the test suite and larger generated ones. The small models show the per-object and per-layer overhead,
+// the large ones the throughput of the algorithms. The models must not change, otherwise the results
+// of different releases are not comparable.
+const std::vector<BenchmarkModel>& reference_models()
+{
+    static const std::vector<BenchmarkModel> models = []() {
+        std::vector<BenchmarkModel> out;
+        out.push_back({ "ipadstand",           mesh(TestMesh::ipadstand) });
+        out.push_back({ "overhang",            mesh(TestMesh::overhang) });
+        out.push_back({ "extruder_idler",      load_model("extruder_idler.obj") });
+        out.push_back({ "frog_legs",           load_model("frog_legs.obj") });
+        // Finely tessellated sphere, about one million triangles.
+        out.push_back({ "sphere_80mm_fine",    make_sphere(40., PI / 500.) });
+        // Array of cylinders, many islands per layer.
+        {
+            indexed_triangle_set its;
+            for (int i = 0; i < 8; ++ i)
+                for (int j = 0; j < 8; ++ j) {
+                    TriangleMesh cylinder = make_cylinder(4., 40., PI / 90.);
+                    cylinder.translate(12.f * i, 12.f * j, 0.f);
+                    its_merge(its, cylinder.its);
+                }
+            out.push_back({ "cylinders_8x8", TriangleMesh(std::move(its)) });
+        }
+        return out;
+    }();
+    return models;
+}
+
+const BenchmarkModel& reference_model(const std::string &name)
+{
+    for (const BenchmarkModel &model : reference_models())
+        if (model.name == name)
+            return model;
+    throw std::runtime_error("Unknown benchmark model " + name);
+}
+
+struct BenchmarkPrint
+{
+    Model   model;
+    Print   print;
+};
+
+// Process the print up to and including the given object step, or the whole print if to_object_step == -1.
+void process_to(Print &print, int to_object_step)
+{
+    PrintBase::TaskParams params;
+    params.to_object_step = to_object_step;
+    print.set_task(params);
+    print.process();
+    print.finalize();
+}
+
+// Print of a model processed up to the step preceding the measured step.
+std::unique_ptr<BenchmarkPrint> prepare_print(const TriangleMesh &mesh, const DynamicPrintConfig &config, int measured_object_step)
+{
+    auto out = std::make_unique<BenchmarkPrint>();
+    init_print({ mesh }, out->print, out->model, config);
+    if (measured_object_step > 0)
+        process_to(out->print, measured_object_step - 1);
+    return out;
+}
+
+DynamicPrintConfig benchmark_config(std::initializer_list<ConfigBase::SetDeserializeItem> items)
+{
+    DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+    config.set_deserialize_strict(items);
+    return config;
+}
+
+// Measure a single PrintObject step, the preceding steps are processed outside of the measurement.
+void benchmark_object_step(const std::string &name, const TriangleMesh &mesh, const DynamicPrintConfig &config, PrintObjectStep step)
+{
+    BENCHMARK_ADVANCED(std::string(name))(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<BenchmarkPrint>> prints;
+        prints.reserve(meter.runs());
+        for (int i = 0; i < meter.runs(); ++ i)
+            prints.emplace_back(prepare_print(mesh, config, int(step)));
+        meter.measure([&prints, step](int i) { process_to(prints[i]->print, int(step)); });
+    };
+}
+
+} // namespace
+
+TEST_CASE("Slicing", "[Benchmarks][Slicing]") {
+    const DynamicPrintConfig config = benchmark_config({ { "layer_height", 0.2 } });
+    for (const BenchmarkModel &model : reference_models())
+        benchmark_object_step("Slice " + model.name, model.mesh, config, posSlice);
+}
+
+TEST_CASE("Perimeters", "[Benchmarks][Perimeters]") {
+    for (const char *generator : { "classic", "arachne" }) {
+        const DynamicPrintConfig config = benchmark_config({ { "perimeter_generator", generator }, { "perimeters", 3 } });
+        for (const BenchmarkModel &model : reference_models())
+            benchmark_object_step(std::string("Perimeters ") + generator + " " + model.name, model.mesh, config, posPerimeters);
+    }
+}
+
+TEST_CASE("Infill", "[Benchmarks][Infill]") {
+    const BenchmarkModel &model = reference_model("sphere_80mm_fine");
+    for (const std::string &pattern : print_config_def.get("fill_pattern")->enum_def->values()) {
+        const DynamicPrintConfig config = benchmark_config({ { "fill_pattern", pattern }, { "fill_density", "20%" } });
+        benchmark_object_step("Infill " + pattern + " " + model.name, model.mesh, config, posInfill);
+    }
+}
+
+TEST_CASE("Support material", "[Benchmarks][Support]") {
+    for (const char *style : { "grid", "snug", "tree", "organic" }) {
+        const DynamicPrintConfig config = benchmark_config({
+            { "support_material", 1 },
+            { "support_material_auto", 1 },
+            { "support_material_style", style }
+        });
+        for (const char *model_name : { "overhang", "frog_legs", "sphere_80mm_fine" })
+            benchmark_object_step(std::string("Support ") + style + " " + model_name, reference_model(model_name).mesh, config, posSupportMaterial);
+    }
+}
+
+TEST_CASE("G-code generation", "[Benchmarks][GCode]") {
+    const DynamicPrintConfig config = benchmark_config({ { "gcode_comments", 0 } });
+    for (const BenchmarkModel &model : reference_models()) {
+        std::unique_ptr<BenchmarkPrint> print = prepare_print(model.mesh, config, 0);
+        process_to(print->print, -1);
+        const std::string path = boost::filesystem::unique_path().string();
+
+        BENCHMARK("Export G-code " + model.name) {
+            return print->print.export_gcode(path, nullptr, nullptr);
+        };
+
+        BENCHMARK("Process G-code " + model.name) {
+            GCodeProcessor processor;
+            processor.process_file(path);
+            return processor.get_result().moves.size();
+        };
+
+        boost::nowide::remove(path.c_str());
+    }
+}
@@ -0,0 +1 @@
+#include <catch_main.hpp>
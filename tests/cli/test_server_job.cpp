@@ -0,0 +1,46 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "CLI/ServerJob.hpp"
+
+using namespace Slic3r;
+using namespace Slic3r::CLI;
+
+TEST_CASE("Server job with configuration options", "[CLI]") {
+    ServerJob   job;
+    std::string error;
+    const bool  ok = parse_server_job(
+        R"({"id": "7", "input": "model.stl", "output": "out.gcode", "config": {"layer_height": "0.15", "fill_density": "20%", "start_gcode": ""}})",
+        job, error);
+    INFO(error);
+    REQUIRE(ok);
+
+    CHECK(job.id == "7");
+    // The configuration options are not passed as command line arguments, thus the empty value
+    // does not swallow the next argument.
+    CHECK(job.args == std::vector<std::string>{ "--output=out.gcode", "--", "model.stl" });
+    CHECK(job.config.opt_float("layer_height") == 0.15);
+    CHECK(job.config.option("fill_density")->serialize() == "20%");
+    CHECK(job.config.opt_string("start_gcode").empty());
+}
+
+TEST_CASE("Server job with invalid configuration options", "[CLI]") {
+    ServerJob   job;
+    std::string error;
+
+    SECTION("Unknown option") {
+        CHECK(! parse_server_job(R"({"input": "model.stl", "config": {"no_such_option": "1"}})", job, error));
+    }
+    SECTION("Command line name instead of the option key") {
+        CHECK(! parse_server_job(R"({"input": "model.stl", "config": {"layer-height": "0.2"}})", job, error));
+    }
+    SECTION("Empty numeric value") {
+        CHECK(! parse_server_job(R"({"input": "model.stl", "config": {"layer_height": ""}})", job, error));
+    }
+    SECTION("Array value") {
+        CHECK(! parse_server_job(R"({"input": "model.stl", "config": {"temperature": ["200", "210"]}})", job, error));
+    }
+    SECTION("Object value") {
+        CHECK(! parse_server_job(R"({"input": "model.stl", "config": {"layer_height": {"value": "0.2"}}})", job, error));
+    }
+    CHECK(! error.empty());
+}
@@ -6,6 +6,7 @@
 #include "libslic3r/libslic3r.h"
 
 #include "libslic3r/ClipperUtils.hpp"
+#include "libslic3r/Fill/FillGyroid.hpp"
 #include "libslic3r/Flow.hpp"
 #include "libslic3r/Layer.hpp"
 #include "libslic3r/Geometry.hpp"
@@ -249,6 +250,34 @@ SCENARIO("Infill does not exceed perimeters", "[Fill]")
     GIVEN("Honeycomb") { test("honeycomb"sv); }
     GIVEN("HilbertCurve") { test("hilbertcurve"sv); }
     GIVEN("Concentric") { test("concentric"sv); }
+    GIVEN("Gyroid") { test("gyroid"sv); }
+}
+
+TEST_CASE("Fill: Gyroid is periodic in Z", "[Fill]") {
+    std::unique_ptr<Slic3r::Fill> filler(Slic3r::Fill::new_from_type("gyroid"));
+    filler->spacing = 0.45;
+    FillParams fill_params;
+    fill_params.density = 0.2f;
+    const ExPolygon expolygon(Polygon::new_scale({ { 0, 0 }, { 50, 0 }, { 50, 30 }, { 0, 30 } }));
+    auto fill = [&filler, &fill_params, &expolygon](double z) {
+        filler->z = z;
+        Slic3r::Surface surface(stInternal, expolygon);
+        return filler->fill_surface(&surface, fill_params);
+    };
+    // Period of the gyroid in Z in millimeters.
+    const double period = 2. * PI * filler->spacing / (fill_params.density * FillGyroid::DensityAdjust);
+
+    for (double z : { 0.2, 1.1, 2.35, 3.7 }) {
+        const Polylines polylines = fill(z);
+        REQUIRE(! polylines.empty());
+        // The second fill of the same layer is served from the cache of the gyroid waves.
+        REQUIRE(fill(z) == polylines);
+        const double length             = total_length(polylines);
+        const double length_next_period = total_length(fill(z + period));
+        REQUIRE(std::abs(length_next_period - length) < 0.01 * length);
+        BoundingBox bbox = get_extents(polylines);
+        REQUIRE(expolygon.contour.bounding_box().inflated(SCALED_EPSILON).contains(bbox));
+    }
 }
 
 // SCENARIO("Infill only where needed", "[Fill]")
@@ -8,8 +8,14 @@
 #include <memory>
 #include <regex>
 #include <fstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/cstdio.hpp>
+#include <boost/nowide/fstream.hpp>
 
 #include "libslic3r/GCode.hpp"
+#include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Geometry/ConvexHull.hpp"
 #include "test_data.hpp"
 
@@ -345,3 +351,94 @@ TEST_CASE("M201 for acceleation reset", "[GCode]") {
     INFO("M204 is not generated for repetier firmware");
     CHECK(!has_m204);
 }
+
+TEST_CASE("Parallel G-code parsing matches the serial one", "[GCode]") {
+    DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+    // Relative extrusion distances make the E coordinate of the reader depend on the order of lines.
+    config.set_deserialize_strict({
+        { "use_relative_e_distances", true },
+    });
+    std::string gcode = Slic3r::Test::slice({TestMesh::cube_with_hole}, config);
+    // Make the file span several chunks.
+    for (size_t i = 0; gcode.size() < 3 * 1024 * 1024; ++ i)
+        gcode += (i % 1000 == 0 ? ";LAYER_CHANGE\n" : "") + std::string("G1 X") + std::to_string(i % 200) + " Y" + std::to_string(i % 150) + " E0.01\n";
+    // Last line without a trailing newline.
+    gcode += "\r\n\r\nG1 X1 Y2 E0.5";
+
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    {
+        boost::nowide::ofstream out(temp.string(), std::ios::binary);
+        out << gcode;
+    }
+
+    struct ParsedLine {
+        std::string raw;
+        float       x, y, e;
+        bool operator==(const ParsedLine &rhs) const { return raw == rhs.raw && x == rhs.x && y == rhs.y && e == rhs.e; }
+    };
+    auto parse = [&temp, &config](bool parallel, std::vector<std::vector<size_t>> &lines_ends) {
+        std::vector<ParsedLine> lines;
+        GCodeReader parser;
+        parser.apply_config(config);
+        // The callbacks may update the UI, they have to be called from the calling thread.
+        const std::thread::id thread_id = std::this_thread::get_id();
+        bool                  other_thread = false;
+        parser.set_progress_callback([&other_thread, thread_id](float) { other_thread |= std::this_thread::get_id() != thread_id; });
+        auto callback = [&lines, &other_thread, thread_id](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+            other_thread |= std::this_thread::get_id() != thread_id;
+            lines.push_back({ line.raw(), reader.x(), reader.y(), reader.e() });
+        };
+        bool ok = parallel ?
+            parser.parse_file_parallel(temp.string(), callback, lines_ends, ";LAYER_CHANGE") :
+            parser.parse_file(temp.string(), callback, lines_ends);
+        REQUIRE(ok);
+        CHECK(! other_thread);
+        return lines;
+    };
+
+    std::vector<std::vector<size_t>> lines_ends_serial;
+    std::vector<std::vector<size_t>> lines_ends_parallel;
+    const std::vector<ParsedLine> serial   = parse(false, lines_ends_serial);
+    const std::vector<ParsedLine> parallel = parse(true, lines_ends_parallel);
+    boost::nowide::remove(temp.string().c_str());
+
+    CHECK(serial.size() > 10);
+    CHECK(serial == parallel);
+    CHECK(lines_ends_serial == lines_ends_parallel);
+}
+
+TEST_CASE("G-code file ending with a lone carriage return", "[GCode]") {
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    {
+        boost::nowide::ofstream out(temp.string(), std::ios::binary);
+        out << "G1 X1 Y2\nG1 X3 Y4\r";
+    }
+    std::vector<std::string> lines;
+    GCodeReader parser;
+    // The memory mapped file must not be read past the trailing '\r'.
+    REQUIRE(parser.parse_file(temp.string(), [&lines](GCodeReader &, const GCodeReader::GCodeLine &line) { lines.emplace_back(line.raw()); }));
+    boost::nowide::remove(temp.string().c_str());
+    CHECK(lines == std::vector<std::string>{ "G1 X1 Y2", "G1 X3 Y4" });
+    CHECK(parser.x() == 3.f);
+    CHECK(parser.y() == 4.f);
+}
+
+TEST_CASE("GCodeLine modification does not alter the parsed buffer", "[GCode]") {
+    const std::string gcode = "G1 X10 Y20 E0.5 ; comment\nM104 S200\n";
+    GCodeReader parser;
+    std::vector<GCodeReader::GCodeLine> modified;
+    parser.parse_buffer(gcode, [&modified](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+        CHECK(line.raw_view() == line.raw());
+        GCodeReader::GCodeLine copy(line);
+        if (copy.cmd_is("G1"))
+            copy.set(reader, X, 15.f, 1);
+        modified.emplace_back(std::move(copy));
+    });
+
+    REQUIRE(modified.size() == 2);
+    CHECK(modified.front().raw() == "G1 X15.0 Y20 E0.5 ; comment");
+    CHECK(modified.front().x() == 15.f);
+    CHECK(modified.front().comment() == " comment");
+    CHECK(modified.back().cmd() == "M104");
+    CHECK(gcode == "G1 X10 Y20 E0.5 ; comment\nM104 S200\n");
+}
@@ -630,3 +630,56 @@ SCENARIO("Seam alignment", "[Perimeters]")
         test(Slic3r::Test::TestMesh::small_dorito);
     }
 }
+
+SCENARIO("Perimeters of identical layers are reused", "[Perimeters]")
+{
+    for (const char *generator : { "classic", "arachne" }) {
+        GIVEN(std::string("20mm cube, ") + generator + " perimeter generator") {
+            Slic3r::Print print;
+            Slic3r::Model model;
+            Slic3r::Test::init_print({ Slic3r::Test::TestMesh::cube_20x20x20 }, print, model, {
+                { "perimeter_generator",    generator },
+                { "perimeters",             3 },
+                { "layer_height",           0.2 },
+                { "first_layer_height",     0.2 }
+            });
+            PrintBase::TaskParams task;
+            task.to_object_step = posPerimeters;
+            print.set_task(task);
+            print.process();
+
+            PrintObject &object = *print.get_object(0);
+            auto perimeter_polylines = [](const Layer &layer) {
+                Polylines out;
+                for (const LayerRegion *layerm : layer.regions())
+                    layerm->perimeters().collect_polylines(out);
+                return out;
+            };
+            THEN("the middle layers have the same perimeters") {
+                REQUIRE(object.layer_count() > 4);
+                const Polylines reference = perimeter_polylines(*object.get_layer(1));
+                REQUIRE(! reference.empty());
+                for (size_t layer_idx = 2; layer_idx + 1 < object.layer_count(); ++ layer_idx)
+                    REQUIRE(perimeter_polylines(*object.get_layer(int(layer_idx))) == reference);
+            }
+            THEN("the reused perimeters match perimeters generated for the layer itself") {
+                Layer &layer = *object.get_layer(int(object.layer_count() / 2));
+                REQUIRE(layer.has_same_perimeter_inputs(*layer.lower_layer));
+                const Polylines reused = perimeter_polylines(layer);
+                size_t          num_islands = 0;
+                for (const LayerSlice &lslice : layer.lslices_ex)
+                    num_islands += lslice.islands.size();
+                layer.make_perimeters();
+                REQUIRE(perimeter_polylines(layer) == reused);
+                size_t num_islands_generated = 0;
+                for (const LayerSlice &lslice : layer.lslices_ex)
+                    num_islands_generated += lslice.islands.size();
+                REQUIRE(num_islands_generated == num_islands);
+            }
+            THEN("the first and the last layer are not reused") {
+                REQUIRE(! object.get_layer(1)->has_same_perimeter_inputs(*object.get_layer(0)));
+                REQUIRE(! object.get_layer(int(object.layer_count() - 1))->has_same_perimeter_inputs(*object.get_layer(int(object.layer_count() - 2))));
+            }
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+
 #include "libslic3r/libslic3r.h"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/Layer.hpp"
@@ -185,3 +187,89 @@ SCENARIO("Ported from Perl", "[Print]") {
         }
     }
 }
+
+SCENARIO("Print: Profiling of the slicing steps", "[Print]") {
+    GIVEN("20mm cube and default config") {
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, { { "fill_density", 0 } });
+        WHEN("the print is processed with the profiler enabled") {
+            print.profiler().enable(true);
+            print.process();
+            const std::vector<PrintProfiler::Event> events = print.profiler().events();
+            auto has_event = [&events](const std::string &category, const std::string &name) {
+                return std::any_of(events.begin(), events.end(), [&category, &name](const PrintProfiler::Event &event) {
+                    return event.category == category && event.name == name;
+                });
+            };
+            THEN("print steps, object steps and layers are recorded") {
+                REQUIRE(has_event("print", "Process"));
+                REQUIRE(has_event("object", "Slice"));
+                REQUIRE(has_event("object", "Perimeters"));
+                REQUIRE(has_event("layer", "Perimeters"));
+            }
+            THEN("events of a single layer are recorded for every layer") {
+                size_t num_layer_events = std::count_if(events.begin(), events.end(), [](const PrintProfiler::Event &event) {
+                    return std::string(event.category) == "layer" && event.name == "Perimeters";
+                });
+                REQUIRE(num_layer_events == print.objects().front()->layers().size());
+            }
+            THEN("the Chrome trace contains all the events") {
+                const std::string trace = print.profiler().chrome_trace();
+                REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+                size_t num_events = 0;
+                for (size_t pos = trace.find("\"ph\":\"X\""); pos != std::string::npos; pos = trace.find("\"ph\":\"X\"", pos + 1))
+                    ++ num_events;
+                REQUIRE(num_events == events.size());
+            }
+        }
+        WHEN("the print is processed with the profiler disabled") {
+            print.process();
+            THEN("no event is recorded") {
+                REQUIRE(print.profiler().events().empty());
+            }
+        }
+    }
+}
+
+SCENARIO("Print: Moving a modifier reuses perimeters and infill of the layers it does not touch", "[Print]") {
+    GIVEN("20mm cube with a modifier adding perimeters to its top 4mm") {
+        const DynamicPrintConfig config = DynamicPrintConfig::full_print_config_with({
+            { "fill_density", "20%" },
+            { "layer_height", 0.2 },
+            { "first_layer_height", 0.2 }
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, config);
+        ModelObject *object = model.objects.front();
+        const BoundingBoxf3 bbox = object->volumes.front()->mesh().transformed_bounding_box(object->volumes.front()->get_matrix());
+        ModelVolume *modifier = object->add_volume(mesh(TestMesh::cube_20x20x20, Vec3d::Zero(), Vec3d(1., 1., 0.2)), ModelVolumeType::PARAMETER_MODIFIER);
+        modifier->config.set("perimeters", 5);
+        modifier->set_offset(Vec3d(bbox.center().x(), bbox.center().y(), bbox.max.z() - 2.));
+        print.apply(model, config);
+        Slic3r::Test::gcode(print);
+        WHEN("the modifier is moved down by 1mm and the print is processed again") {
+            modifier->set_offset(modifier->get_offset() - Vec3d(0., 0., 1.));
+            print.apply(model, config);
+            print.profiler().enable(true);
+            const std::string gcode_incremental = Slic3r::Test::gcode(print);
+            const std::vector<PrintProfiler::Event> events = print.profiler().events();
+            auto num_layer_events = [&events](const std::string &name) {
+                return std::count_if(events.begin(), events.end(), [&name](const PrintProfiler::Event &event) {
+                    return std::string(event.category) == "layer" && event.name == name;
+                });
+            };
+            THEN("perimeters and infill of the layers below the modifier are reused") {
+                REQUIRE(num_layer_events("Perimeters (reused)") > 0);
+                REQUIRE(num_layer_events("Infill (reused)") > 0);
+            }
+            THEN("the G-code is the same as the G-code of the print processed from scratch") {
+                Slic3r::Print print_from_scratch;
+                print_from_scratch.apply(model, config);
+                print_from_scratch.validate();
+                REQUIRE(gcode_incremental == Slic3r::Test::gcode(print_from_scratch));
+            }
+        }
+    }
+}
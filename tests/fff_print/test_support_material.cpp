@@ -2,6 +2,17 @@
 
 #include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Layer.hpp"
+#include "libslic3r/BuildVolume.hpp"
+#include "libslic3r/Support/TreeModelVolumes.hpp"
+#include "libslic3r/Utils.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+
+#include <atomic>
+#include <limits>
+
+#include <oneapi/tbb/parallel_for.h>
 
 #include "test_data.hpp" // get access to init_print, etc
 
@@ -119,6 +130,156 @@ SCENARIO("SupportMaterial: support_layers_z and contact_distance", "[SupportMate
     }
 }
 
+// Box h = 20mm with a horizontal hole, whose ceiling has to be supported.
+static TriangleMesh tree_support_test_mesh()
+{
+    TriangleMesh mesh = Slic3r::Test::mesh(Slic3r::Test::TestMesh::cube_with_hole);
+    mesh.rotate_x(float(M_PI / 2));
+    return mesh;
+}
+
+// Points the tree support disk cache to a directory (an empty one disables the cache) until the end of the scope,
+// restoring the previous directory even if a REQUIRE fails.
+class TreeSupportDiskCacheScope
+{
+public:
+    explicit TreeSupportDiskCacheScope(const std::string &dir) : m_old_dir(FFFTreeSupport::TreeModelVolumes::disk_cache_directory())
+        { FFFTreeSupport::TreeModelVolumes::set_disk_cache_directory(dir); }
+    ~TreeSupportDiskCacheScope() { FFFTreeSupport::TreeModelVolumes::set_disk_cache_directory(m_old_dir); }
+
+private:
+    std::string m_old_dir;
+};
+
+// Tree support model volumes of tree_support_test_mesh() sliced with organic supports, not backed by the disk cache.
+struct TreeModelVolumesFixture
+{
+    TreeModelVolumesFixture() {
+        Slic3r::Test::init_and_process_print({ tree_support_test_mesh() }, print, {
+            { "support_material",       1 },
+            { "support_material_style", "organic" }
+        });
+        config    = FFFTreeSupport::TreeSupportSettings{ FFFTreeSupport::TreeSupportMeshGroupSettings(object()), object().slicing_parameters() };
+        max_layer = FFFTreeSupport::LayerIndex(object().layer_count()) - 1;
+    }
+
+    const PrintObject& object() const { return *print.objects().front(); }
+    FFFTreeSupport::TreeModelVolumes make_volumes() const
+        { return FFFTreeSupport::TreeModelVolumes{ object(), build_volume, config.maximum_move_distance, config.maximum_move_distance_slow, 0 }; }
+
+    TreeSupportDiskCacheScope           disk_cache { {} };
+    Slic3r::Print                       print;
+    FFFTreeSupport::TreeSupportSettings config;
+    const BuildVolume                   build_volume { Pointfs{ { 0., 0. }, { 200., 0. }, { 200., 200. }, { 0., 200. } }, 200. };
+    FFFTreeSupport::LayerIndex          max_layer { 0 };
+};
+
+TEST_CASE("SupportMaterial: tree support volumes are cached on disk", "[SupportMaterial]")
+{
+    const TriangleMesh mesh = tree_support_test_mesh();
+
+    const boost::filesystem::path cache_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    ScopeGuard remove_cache_dir([&cache_dir]() {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(cache_dir, ec);
+    });
+    TreeSupportDiskCacheScope disk_cache(cache_dir.string());
+    auto cache_files = [&cache_dir]() {
+        std::vector<boost::filesystem::path> files;
+        for (boost::filesystem::directory_iterator it(cache_dir), end; it != end; ++ it)
+            if (it->path().extension() == ".tmv")
+                files.emplace_back(it->path());
+        return files;
+    };
+    auto num_cache_files = [&cache_files]() { return cache_files().size(); };
+
+    DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config_with({
+        { "support_material",       1 },
+        { "support_material_style", "organic" },
+        { "fill_density",           "20%" }
+    });
+    const std::string gcode_computed = Slic3r::Test::slice({ mesh }, config);
+    REQUIRE(num_cache_files() == 1);
+
+    SECTION("Slicing again loads the cached volumes and produces the same G-code") {
+        const std::string gcode_cached = Slic3r::Test::slice({ mesh }, config);
+        REQUIRE(num_cache_files() == 1);
+        REQUIRE(gcode_cached == gcode_computed);
+    }
+    SECTION("Changing a parameter not related to supports reuses the cached volumes") {
+        config.set_deserialize_strict({ { "fill_density", "40%" } });
+        Slic3r::Test::slice({ mesh }, config);
+        REQUIRE(num_cache_files() == 1);
+    }
+    SECTION("Changing a support parameter creates a new cache file") {
+        config.set_deserialize_strict({ { "support_material_xy_spacing", "100%" } });
+        Slic3r::Test::slice({ mesh }, config);
+        REQUIRE(num_cache_files() == 2);
+    }
+    SECTION("A truncated cache file is recalculated and replaced") {
+        const boost::filesystem::path path = cache_files().front();
+        const uintmax_t               size = boost::filesystem::file_size(path);
+        boost::filesystem::resize_file(path, size / 2);
+        const std::string gcode_recalculated = Slic3r::Test::slice({ mesh }, config);
+        REQUIRE(gcode_recalculated == gcode_computed);
+        REQUIRE(num_cache_files() == 1);
+        REQUIRE(boost::filesystem::file_size(path) == size);
+    }
+    SECTION("A cache file with a corrupted polygon count is recalculated") {
+        const boost::filesystem::path path = cache_files().front();
+        {
+            // Overwrite the number of entries of the first cache following the header.
+            boost::nowide::fstream file(path.string(), std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(3 * sizeof(uint32_t) + sizeof(uint64_t));
+            const uint64_t huge = std::numeric_limits<uint64_t>::max() / 2;
+            file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+        }
+        REQUIRE(Slic3r::Test::slice({ mesh }, config) == gcode_computed);
+        REQUIRE(num_cache_files() == 1);
+    }
+}
+
+TEST_CASE("SupportMaterial: tree support avoidances calculated on demand match the precalculated ones", "[SupportMaterial]")
+{
+    const TreeModelVolumesFixture     fixture;
+    const auto                       &config    = fixture.config;
+    const FFFTreeSupport::LayerIndex  max_layer = fixture.max_layer;
+    FFFTreeSupport::TreeModelVolumes precalculated = fixture.make_volumes();
+    precalculated.precalculate(fixture.object(), max_layer, false, []{});
+    FFFTreeSupport::TreeModelVolumes on_demand = fixture.make_volumes();
+    on_demand.precalculate(fixture.object(), max_layer, true, []{});
+
+    using AvoidanceType = FFFTreeSupport::TreeModelVolumes::AvoidanceType;
+    for (coord_t radius : { config.getRadius(0), config.branch_radius })
+        for (FFFTreeSupport::LayerIndex layer_idx : { max_layer, max_layer / 2, FFFTreeSupport::LayerIndex(1) })
+            for (AvoidanceType type : { AvoidanceType::Slow, AvoidanceType::FastSafe, AvoidanceType::Fast })
+                for (bool to_model : { false, true })
+                    REQUIRE(on_demand.getAvoidance(radius, layer_idx, type, to_model, true) == precalculated.getAvoidance(radius, layer_idx, type, to_model, true));
+}
+
+TEST_CASE("SupportMaterial: canceling tree support avoidances calculated on demand", "[SupportMaterial]")
+{
+    const TreeModelVolumesFixture     fixture;
+    const auto                       &config    = fixture.config;
+    const FFFTreeSupport::LayerIndex  max_layer = fixture.max_layer;
+    FFFTreeSupport::TreeModelVolumes volumes = fixture.make_volumes();
+    struct Canceled {};
+    std::atomic<bool> canceled { false };
+    volumes.precalculate(fixture.object(), max_layer, true, [&canceled]{ if (canceled) throw Canceled(); });
+    canceled = true;
+
+    // All the threads requesting the same avoidance are released with the exception.
+    std::atomic<int> num_canceled { 0 };
+    tbb::parallel_for(0, 4, [&](int) {
+        try {
+            volumes.getAvoidance(config.branch_radius, max_layer, FFFTreeSupport::TreeModelVolumes::AvoidanceType::Slow, false, true);
+        } catch (const Canceled &) {
+            ++ num_canceled;
+        }
+    });
+    REQUIRE(num_canceled == 4);
+}
+
 #if 0
 // Test 8.
 TEST_CASE("SupportMaterial: forced support is generated", "[SupportMaterial]")
@@ -153,6 +153,26 @@ SCENARIO( "TriangleMesh: slice behavior.") {
             }
         }
     }
+    GIVEN( "A sphere") {
+        TriangleMesh sphere = make_sphere(10., 2. * PI / 180.);
+        sphere.translate(0., 0., 10.);
+        WHEN("Sphere is sliced at many layers at once") {
+            std::vector<float> zs;
+            for (float z = 0.1f; z < 20.f; z += 0.2f)
+                zs.emplace_back(z);
+            std::vector<ExPolygons> result = slice_mesh_ex(sphere.its, zs);
+            THEN( "Each layer matches the layer sliced alone.") {
+                REQUIRE(result.size() == zs.size());
+                for (size_t i = 0U; i < zs.size(); i++) {
+                    std::vector<ExPolygons> single = slice_mesh_ex(sphere.its, { zs[i] });
+                    REQUIRE(result[i].size() == 1);
+                    REQUIRE(single.front().size() == 1);
+                    REQUIRE(result[i].front().contour.size() == single.front().front().contour.size());
+                    REQUIRE(std::abs(result[i].front().area() - single.front().front().area()) < 1e-6 * single.front().front().area());
+                }
+            }
+        }
+    }
     GIVEN( "A STL with an irregular shape.") {
         const std::vector<Vec3f> vertices {{0,0,0},{0,0,20},{0,5,0},{0,5,20},{50,0,0},{50,0,20},{15,5,0},{35,5,0},{15,20,0},{50,5,0},{35,20,0},{15,5,10},{50,5,20},{35,5,10},{35,20,10},{15,20,10}};
         const std::vector<Vec3i> facets {{0,1,2},{2,1,3},{1,0,4},{5,1,4},{0,2,4},{4,2,6},{7,6,8},{4,6,7},{9,4,7},{7,8,10},{2,3,6},{11,3,12},{7,12,9},{13,12,7},{6,3,11},{11,12,13},{3,1,5},{12,3,5},{5,4,9},{12,5,9},{13,7,10},{14,13,10},{8,15,10},{10,15,14},{6,11,8},{8,11,15},{15,11,13},{14,15,13}};
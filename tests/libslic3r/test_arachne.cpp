@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <optional>
 
 #include "libslic3r/Arachne/WallToolPaths.hpp"
+#include "libslic3r/Arachne/BeadingStrategy/BeadingStrategyFactory.hpp"
+#include "libslic3r/Arachne/BeadingStrategy/CachedBeadingStrategy.hpp"
 #include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/SVG.hpp"
 #include "libslic3r/Utils.hpp"
@@ -900,4 +903,121 @@ TEST_CASE("Arachne - SPE-2496 - Negative extrusion width", "[Arachne_Negative_Ex
     }
 
     REQUIRE(!has_negative_extrusion_width);
-}
\ No newline at end of file
+}
+TEST_CASE("Arachne - Islands are processed independently", "[ArachneIslands]") {
+    // A grid of islands of different shapes: squares with a hole and thin rectangles.
+    Polygons polygons;
+    for (int i = 0; i < 4; ++ i)
+        for (int j = 0; j < 4; ++ j) {
+            const Point origin(scaled<coord_t>(12. * i), scaled<coord_t>(12. * j));
+            if ((i + j) % 2 == 0) {
+                Polygon contour = Polygon::new_scale({ {0., 0.}, {10., 0.}, {10., 10.}, {0., 10.} });
+                Polygon hole    = Polygon::new_scale({ {3., 3.}, {3., 7.}, {7., 7.}, {7., 3.} });
+                contour.translate(origin);
+                hole.translate(origin);
+                polygons.emplace_back(std::move(contour));
+                polygons.emplace_back(std::move(hole));
+            } else {
+                Polygon rectangle = Polygon::new_scale({ {0., 0.}, {10., 0.}, {10., 0.6 + 0.3 * j}, {0., 0.6 + 0.3 * j} });
+                rectangle.translate(origin);
+                polygons.emplace_back(std::move(rectangle));
+            }
+        }
+
+    coord_t spacing     = 407079;
+    coord_t inset_count = 3;
+
+    auto total_length = [](const Arachne::Perimeters &perimeters, size_t inset_idx) {
+        double length = 0.;
+        if (inset_idx < perimeters.size())
+            for (const Arachne::ExtrusionLine &extrusion_line : perimeters[inset_idx])
+                length += extrusion_line.getLength();
+        return length;
+    };
+
+    Arachne::WallToolPaths wall_tool_paths(polygons, spacing, spacing, inset_count, 0, 0.2, PrintObjectConfig::defaults(), PrintConfig::defaults());
+    const Arachne::Perimeters perimeters    = wall_tool_paths.getToolPaths();
+    const double              inner_area    = area(wall_tool_paths.getInnerContour());
+
+    // Process each island alone and accumulate the results.
+    std::vector<double> island_lengths(perimeters.size(), 0.);
+    double              islands_inner_area = 0.;
+    size_t              max_insets         = 0;
+    for (const ExPolygon &island : union_ex(polygons)) {
+        const Polygons         island_polygons = to_polygons(island);
+        Arachne::WallToolPaths island_tool_paths(island_polygons, spacing, spacing, inset_count, 0, 0.2, PrintObjectConfig::defaults(), PrintConfig::defaults());
+        const Arachne::Perimeters island_perimeters = island_tool_paths.getToolPaths();
+        max_insets = std::max(max_insets, island_perimeters.size());
+        for (size_t inset_idx = 0; inset_idx < std::min(island_perimeters.size(), island_lengths.size()); ++ inset_idx)
+            island_lengths[inset_idx] += total_length(island_perimeters, inset_idx);
+        islands_inner_area += area(island_tool_paths.getInnerContour());
+    }
+
+    REQUIRE(max_insets == perimeters.size());
+    for (size_t inset_idx = 0; inset_idx < perimeters.size(); ++ inset_idx)
+        CHECK(std::abs(total_length(perimeters, inset_idx) - island_lengths[inset_idx]) < 1e-3 * island_lengths[inset_idx]);
+    CHECK(std::abs(inner_area - islands_inner_area) < 1e-3 * islands_inner_area);
+}
+
+TEST_CASE("Arachne - Cached beading strategy", "[ArachneCachedBeading]") {
+    const coord_t bead_width = scaled<coord_t>(0.45);
+    auto make = [bead_width](auto factory) {
+        return factory(bead_width, bead_width, scaled<coord_t>(0.4), float(M_PI / 4.), true, scaled<coord_t>(0.1), scaled<coord_t>(0.1), 0.5, 0.5, coord_t(6), coord_t(0), 1, 0.5);
+    };
+    const BeadingStrategyPtr                     strategy        = make(BeadingStrategyFactory::makeStrategy);
+    std::optional<BeadingStrategyFactory::CacheScope> cache_scope;
+    cache_scope.emplace();
+    const std::shared_ptr<const BeadingStrategy> cached_strategy = make(BeadingStrategyFactory::makeCachedStrategy);
+
+    SECTION("Strategies with the same parameters are shared") {
+        REQUIRE(cached_strategy == make(BeadingStrategyFactory::makeCachedStrategy));
+    }
+
+    SECTION("Strategies are released with the last cache scope") {
+        {
+            BeadingStrategyFactory::CacheScope nested_scope;
+        }
+        REQUIRE(cached_strategy == make(BeadingStrategyFactory::makeCachedStrategy));
+        cache_scope.reset();
+        const std::shared_ptr<const BeadingStrategy> uncached_strategy = make(BeadingStrategyFactory::makeCachedStrategy);
+        REQUIRE(uncached_strategy != cached_strategy);
+        REQUIRE(dynamic_cast<const CachedBeadingStrategy*>(uncached_strategy.get()) == nullptr);
+    }
+
+    SECTION("Cache keeps memoizing once the shards were filled") {
+        // Many more distinct thicknesses than the cache capacity.
+        const coord_t num_thicknesses = 100000;
+        for (coord_t thickness = 0; thickness < num_thicknesses; ++ thickness)
+            cached_strategy->compute(thickness, 2);
+        const auto  &cache      = static_cast<const CachedBeadingStrategy&>(*cached_strategy);
+        const size_t num_cached = cache.num_cached_beadings();
+        REQUIRE(num_cached < size_t(num_thicknesses));
+        // A thickness evaluated after all the shards were filled is still cached.
+        cached_strategy->compute(num_thicknesses, 2);
+        REQUIRE(cache.num_cached_beadings() != num_cached);
+        const BeadingStrategy::Beading expected = strategy->compute(num_thicknesses, 2);
+        const BeadingStrategy::Beading cached   = cached_strategy->compute(num_thicknesses, 2);
+        REQUIRE(cached.bead_widths == expected.bead_widths);
+        REQUIRE(cached.toolpath_locations == expected.toolpath_locations);
+    }
+
+    SECTION("Cached beadings are equal to the calculated ones") {
+        // Each thickness is evaluated twice, the second evaluation is served from the cache.
+        for (int pass = 0; pass < 2; ++ pass)
+            for (coord_t thickness = 0; thickness < scaled<coord_t>(4.); thickness += scaled<coord_t>(0.0137)) {
+                const coord_t bead_count = strategy->getOptimalBeadCount(thickness);
+                REQUIRE(cached_strategy->getOptimalBeadCount(thickness) == bead_count);
+                for (coord_t count : { bead_count, bead_count + 1 }) {
+                    if (count > 7)
+                        continue;
+                    const BeadingStrategy::Beading expected = strategy->compute(thickness, count);
+                    const BeadingStrategy::Beading cached   = cached_strategy->compute(thickness, count);
+                    REQUIRE(cached.total_thickness == expected.total_thickness);
+                    REQUIRE(cached.bead_widths == expected.bead_widths);
+                    REQUIRE(cached.toolpath_locations == expected.toolpath_locations);
+                    REQUIRE(cached.left_over == expected.left_over);
+                }
+            }
+        REQUIRE(static_cast<const CachedBeadingStrategy&>(*cached_strategy).num_cached_beadings() > 0);
+    }
+}
@@ -384,3 +384,83 @@ TEST_CASE("Traversing Clipper PolyTree", "[ClipperUtils]") {
         REQUIRE(count_polys(output) == reference.size());
     }
 }
+
+TEST_CASE("Reusing Clipper engines of a thread", "[ClipperUtils]") {
+    const Polygon square = Polygon::new_scale({ { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 } });
+    const Polygon hole   = Polygon::new_scale({ { 2, 2 }, { 2, 8 }, { 8, 8 }, { 8, 2 } });
+
+    SECTION("Nested scopes get different engines") {
+        ClipperUtils::ClipperScope outer;
+        ClipperUtils::ClipperScope inner;
+        REQUIRE(&*outer != &*inner);
+    }
+    SECTION("The engine of the thread is reused with default parameters") {
+        ClipperLib::Clipper *engine = nullptr;
+        {
+            ClipperUtils::ClipperScope clipper;
+            engine = &*clipper;
+            clipper->ReverseSolution(true);
+            clipper->StrictlySimple(true);
+            clipper->AddPath(square.points, ClipperLib::ptSubject, true);
+        }
+        ClipperUtils::ClipperScope clipper;
+        REQUIRE(&*clipper == engine);
+        REQUIRE(! clipper->ReverseSolution());
+        REQUIRE(! clipper->StrictlySimple());
+        // The paths of the previous scope were cleared.
+        ClipperLib::Paths out;
+        clipper->Execute(ClipperLib::ctUnion, out, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        REQUIRE(out.empty());
+    }
+    SECTION("Repeated operations give the same results") {
+        const ExPolygons   reference_diff   = diff_ex(Polygons{ square }, Polygons{ hole });
+        const Polygons     reference_offset = offset(square, scaled<float>(1.));
+        for (size_t i = 0; i < 10; ++ i) {
+            REQUIRE(diff_ex(Polygons{ square }, Polygons{ hole }) == reference_diff);
+            REQUIRE(offset(square, scaled<float>(1.)) == reference_offset);
+            REQUIRE(shrink(Polygons{ square }, scaled<float>(1.)).size() == 1);
+        }
+        REQUIRE(reference_diff.size() == 1);
+        REQUIRE(reference_diff.front().holes.size() == 1);
+    }
+}
+
+TEST_CASE("Batched boolean operations", "[ClipperUtils]") {
+    Polygons   squares;
+    ExPolygons frames;
+    for (int i = 0; i < 50; ++ i) {
+        const double x = 20. * i;
+        squares.push_back(Polygon::new_scale({ { x, 0 }, { x + 10, 0 }, { x + 10, 10 }, { x, 10 } }));
+        ExPolygon frame(Polygon::new_scale({ { x + 5, 5 }, { x + 15, 5 }, { x + 15, 15 }, { x + 5, 15 } }));
+        frame.holes.push_back(Polygon::new_scale({ { x + 7, 7 }, { x + 7, 13 }, { x + 13, 13 }, { x + 13, 7 } }));
+        frames.push_back(std::move(frame));
+    }
+    const Polygons far_away { Polygon::new_scale({ { 0, 100 }, { 10, 100 }, { 10, 110 }, { 0, 110 } }) };
+
+    std::vector<Polygons> subjects;
+    for (const Polygon &square : squares)
+        subjects.push_back({ square });
+
+    ClipperBatch batch;
+    for (size_t i = 0; i < subjects.size(); ++ i) {
+        REQUIRE(batch.add(ClipperLib::ctDifference, subjects[i], frames[i]) == 3 * i);
+        batch.add(ClipperLib::ctIntersection, subjects[i], frames[i]);
+        batch.add(ClipperLib::ctIntersection, subjects[i], far_away);
+    }
+    REQUIRE(batch.size() == 3 * subjects.size());
+
+    for (bool parallel : { false, true }) {
+        std::vector<Polygons>   results    = batch.execute(parallel);
+        std::vector<ExPolygons> results_ex = batch.execute_ex(parallel);
+        REQUIRE(results.size() == batch.size());
+        REQUIRE(results_ex.size() == batch.size());
+        for (size_t i = 0; i < subjects.size(); ++ i) {
+            REQUIRE(results[3 * i] == diff(subjects[i], ExPolygons{ frames[i] }));
+            REQUIRE(results[3 * i + 1] == intersection(subjects[i], frames[i]));
+            REQUIRE(results[3 * i + 2].empty());
+            REQUIRE(results_ex[3 * i] == diff_ex(subjects[i], ExPolygons{ frames[i] }));
+            REQUIRE(results_ex[3 * i + 1] == intersection_ex(subjects[i], ExPolygons{ frames[i] }));
+            REQUIRE(results_ex[3 * i + 2].empty());
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "libslic3r/EdgeGrid.hpp"
+#include "libslic3r/ExPolygon.hpp"
+#include "libslic3r/Geometry.hpp"
+
+using namespace Slic3r;
+
+// Reference implementation: the distance to the closest segment of all the contours.
+static double closest_segment_distance(const ExPolygons &expolygons, const Point &pt)
+{
+    double d_min = std::numeric_limits<double>::max();
+    for (const ExPolygon &expolygon : expolygons)
+        for (const Line &line : to_lines(expolygon))
+            d_min = std::min(d_min, line.distance_to(pt));
+    return d_min;
+}
+
+TEST_CASE("EdgeGrid distance queries match the distances to the closest segments", "[EdgeGrid]") {
+    // A circle with a square hole and a star, so that the cells reference many segments of different contours.
+    ExPolygon circle;
+    circle.contour = Polygon::new_scale([]() {
+        std::vector<Vec2d> pts;
+        for (size_t i = 0; i < 360; ++ i)
+            pts.emplace_back(20. * cos(2. * PI * i / 360.), 20. * sin(2. * PI * i / 360.));
+        return pts;
+    }());
+    Polygon hole = Polygon::new_scale({ { -5., -5. }, { -5., 5. }, { 5., 5. }, { 5., -5. } });
+    circle.holes.emplace_back(hole);
+    ExPolygon star;
+    star.contour = Polygon::new_scale([]() {
+        std::vector<Vec2d> pts;
+        for (size_t i = 0; i < 40; ++ i) {
+            const double r = i % 2 ? 3. : 8.;
+            pts.emplace_back(40. + r * cos(2. * PI * i / 40.), r * sin(2. * PI * i / 40.));
+        }
+        return pts;
+    }());
+    const ExPolygons expolygons { circle, star };
+
+    EdgeGrid::Grid grid;
+    grid.create(expolygons, scaled<coord_t>(2.));
+
+    const coord_t  search_radius = scaled<coord_t>(3.);
+    std::mt19937   rng(0);
+    std::uniform_real_distribution<double> dist_x(-25., 50.), dist_y(-25., 25.);
+    size_t         num_found = 0;
+    for (size_t i = 0; i < 10000; ++ i) {
+        const Point  pt = Point::new_scale(dist_x(rng), dist_y(rng));
+        const double expected = closest_segment_distance(expolygons, pt);
+
+        const EdgeGrid::Grid::ClosestPointResult closest = grid.closest_point_signed_distance(pt, search_radius);
+        coordf_t signed_distance = 0.;
+        const bool found = grid.signed_distance_edges(pt, search_radius, signed_distance);
+        if (expected < double(search_radius) - 1.) {
+            REQUIRE(closest.valid());
+            REQUIRE(std::abs(std::abs(closest.distance) - expected) < 1.);
+            REQUIRE(found);
+            REQUIRE(std::abs(std::abs(signed_distance) - expected) < 1.);
+            // Positive outside, negative inside of the expolygons.
+            REQUIRE((signed_distance < 0) == (circle.contains(pt) || star.contains(pt)));
+            ++ num_found;
+        } else if (expected > double(search_radius) + 1.) {
+            REQUIRE(! closest.valid());
+            REQUIRE(! found);
+        }
+    }
+    REQUIRE(num_found > 1000);
+}
@@ -103,6 +103,33 @@ TEST_CASE("Split two watertight meshes", "[its_split][its]") {
     debug_write_obj(res, "parts_watertight");
 }
 
+TEST_CASE("Repair mesh with unshared vertices, flipped and degenerate faces", "[its_repair][its]") {
+    using namespace Slic3r;
+
+    const indexed_triangle_set sphere = its_make_sphere(10., 2 * PI / 50.);
+
+    // Each face references its own copy of the vertices, some faces are flipped, the whole mesh is inside out.
+    indexed_triangle_set its;
+    for (size_t face_idx = 0; face_idx < sphere.indices.size(); ++ face_idx) {
+        const Vec3i &face = sphere.indices[face_idx];
+        const int    idx  = int(its.vertices.size());
+        for (int i = 0; i < 3; ++ i)
+            its.vertices.emplace_back(sphere.vertices[face(i)]);
+        its.indices.emplace_back(face_idx % 7 == 0 ? Vec3i(idx, idx + 1, idx + 2) : Vec3i(idx, idx + 2, idx + 1));
+    }
+    // Degenerate face.
+    its.indices.emplace_back(its.indices.front()(0), its.indices.front()(1), its.indices.front()(1));
+
+    RepairedMeshErrors errors = its_repair(its);
+
+    CHECK(errors.degenerate_facets == 1);
+    CHECK(errors.facets_reversed > 0);
+    CHECK(its.indices.size() == sphere.indices.size());
+    CHECK(its.vertices.size() == sphere.vertices.size());
+    CHECK(its_num_open_edges(its) == 0);
+    CHECK(std::abs(its_volume(its) - its_volume(sphere)) < 1e-3 * its_volume(sphere));
+}
+
 #include <libslic3r/QuadricEdgeCollapse.hpp>
 static float triangle_area(const Vec3f &v0, const Vec3f &v1, const Vec3f &v2)
 {
@@ -9,6 +9,7 @@
 #include "libslic3r/PNGReadWrite.hpp"
 #include "libslic3r/SLA/AGGRaster.hpp"
 #include "libslic3r/BoundingBox.hpp"
+#include "libslic3r/miniz_extension.hpp"
 
 using namespace Slic3r;
 
@@ -56,3 +57,24 @@ TEST_CASE("PNG read", "[PNG]") {
         REQUIRE(sum == rstsum);
     }
 }
+
+TEST_CASE("PNG of a large image compressed in parallel", "[PNG]") {
+    // Large enough to be split into several independently compressed blocks.
+    const size_t w = 1500, h = 1200;
+    std::vector<uint8_t> pixels(w * h);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = uint8_t((i * 7919) % 251 < 128 ? i % 13 : 0);
+
+    size_t png_size = 0;
+    void  *png_data = write_image_to_png_file_in_memory_parallel(pixels.data(), int(w), int(h), 1, &png_size, MZ_DEFAULT_LEVEL, false);
+    REQUIRE(png_data != nullptr);
+    REQUIRE(Slic3r::png::is_png({png_data, png_size}));
+
+    png::ImageGreyscale img;
+    REQUIRE(png::decode_png({png_data, png_size}, img));
+    mz_free(png_data);
+
+    REQUIRE(img.rows == h);
+    REQUIRE(img.cols == w);
+    REQUIRE(img.buf == pixels);
+}
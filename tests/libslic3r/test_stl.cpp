@@ -1,8 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "libslic3r/Model.hpp"
+#include "libslic3r/TriangleMesh.hpp"
 #include "libslic3r/Format/STL.hpp"
 
+#include <boost/filesystem/operations.hpp>
+
 using namespace Slic3r;
 
 static inline std::string stl_path(const char* path)
@@ -20,6 +23,40 @@ SCENARIO("Reading an STL file", "[stl]") {
             }
         }
     }
+	GIVEN("a closed binary STL file") {
+		WHEN("STL file is read") {
+			Slic3r::Model model;
+			TriangleMesh  admesh;
+			REQUIRE(Slic3r::load_stl(stl_path("Geräte/20mmbox-čřšřěá.stl").c_str(), &model));
+			REQUIRE(admesh.ReadSTLFile(stl_path("Geräte/20mmbox-čřšřěá.stl").c_str()));
+			THEN("the mesh matches the mesh loaded and repaired by admesh") {
+				const TriangleMesh &mesh = model.objects.front()->volumes.front()->mesh();
+				REQUIRE(mesh.facets_count() == admesh.facets_count());
+				REQUIRE(mesh.its.vertices.size() == admesh.its.vertices.size());
+				REQUIRE(mesh.stats().open_edges == 0);
+				REQUIRE(std::abs(mesh.stats().volume - admesh.stats().volume) < 1e-3);
+			}
+		}
+	}
+	GIVEN("an open binary STL file") {
+		indexed_triangle_set its = its_make_cube(20., 20., 20.);
+		its.indices.pop_back();
+		const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.stl")).string();
+		TriangleMesh(std::move(its)).write_binary(path.c_str());
+		WHEN("STL file is read") {
+			Slic3r::Model model;
+			TriangleMesh  admesh;
+			const bool    loaded = Slic3r::load_stl(path.c_str(), &model);
+			REQUIRE(admesh.ReadSTLFile(path.c_str()));
+			boost::filesystem::remove(path);
+			THEN("it is loaded and repaired by admesh") {
+				REQUIRE(loaded);
+				const TriangleMesh &mesh = model.objects.front()->volumes.front()->mesh();
+				REQUIRE(mesh.facets_count() == admesh.facets_count());
+				REQUIRE(mesh.stats().open_edges == admesh.stats().open_edges);
+			}
+		}
+	}
 	GIVEN("in ASCII format") {
 		WHEN("line endings LF") {
 			Slic3r::Model model;
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "libslic3r/Geometry.hpp"
+#include "libslic3r/TriangleMesh.hpp"
+#include "libslic3r/TriangleMeshSlicer.hpp"
+#include "libslic3r/VolumeSlicesCache.hpp"
+
+using namespace Slic3r;
+
+static bool slices_equal(const std::vector<ExPolygons> &lhs, const std::vector<ExPolygons> &rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (size_t i = 0; i < lhs.size(); ++ i)
+        if (lhs[i] != rhs[i])
+            return false;
+    return true;
+}
+
+TEST_CASE("Cached slices match the slices of slice_mesh_ex()", "[VolumeSlicesCache]") {
+    auto mesh = std::make_shared<const TriangleMesh>(its_make_sphere(10., 0.5));
+    MeshSlicingParamsEx params;
+    params.trafo          = Geometry::translation_transform(Vec3d(0., 0., 10.));
+    params.closing_radius = 0.005f;
+
+    std::vector<float> zs;
+    for (float z = 0.1f; z < 20.f; z += 0.2f)
+        zs.emplace_back(z);
+
+    VolumeSlicesCache cache;
+    auto no_cancel = []() {};
+    const std::vector<ExPolygons> reference = slice_mesh_ex(mesh->its, zs, params);
+    REQUIRE(slices_equal(cache.slice(mesh, zs, params, no_cancel), reference));
+    REQUIRE(cache.memory_used() > 0);
+
+    SECTION("Repeated query is served from the cache") {
+        CHECK(slices_equal(cache.slice(mesh, zs, params, no_cancel), reference));
+    }
+
+    SECTION("Layer height changed in a Z range") {
+        std::vector<float> zs2;
+        for (float z : zs)
+            if (z < 5.f || z > 8.f)
+                zs2.emplace_back(z);
+        for (float z = 5.05f; z < 8.f; z += 0.1f)
+            zs2.emplace_back(z);
+        std::sort(zs2.begin(), zs2.end());
+        CHECK(slices_equal(cache.slice(mesh, zs2, params, no_cancel), slice_mesh_ex(mesh->its, zs2, params)));
+    }
+
+    SECTION("Different slicing parameters are not mixed") {
+        MeshSlicingParamsEx params2 { params };
+        params2.extra_offset = 0.5f;
+        CHECK(slices_equal(cache.slice(mesh, zs, params2, no_cancel), slice_mesh_ex(mesh->its, zs, params2)));
+    }
+
+    SECTION("Meshes not referenced anymore are dropped") {
+        auto mesh2 = std::make_shared<const TriangleMesh>(its_make_cube(5., 5., 5.));
+        cache.slice(mesh2, zs, params, no_cancel);
+        const size_t memory_used = cache.memory_used();
+        mesh.reset();
+        // Any query evicts the meshes held by the cache only.
+        cache.slice(mesh2, zs, params, no_cancel);
+        CHECK(cache.memory_used() < memory_used);
+    }
+}
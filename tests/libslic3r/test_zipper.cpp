@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "libslic3r/Zipper.hpp"
+#include "libslic3r/miniz_extension.hpp"
+
+using namespace Slic3r;
+
+// Compressible, but not trivially repeating data.
+static std::vector<unsigned char> make_data(size_t size, uint32_t seed)
+{
+    std::vector<unsigned char> data(size);
+    uint32_t state = seed;
+    for (size_t i = 0; i < size; ++ i) {
+        state = state * 1664525u + 1013904223u;
+        // Runs of the same byte mixed with noise.
+        data[i] = (state >> 28) < 4 ? (unsigned char)(state >> 16) : (unsigned char)('a' + (i / 97) % 26);
+    }
+    return data;
+}
+
+TEST_CASE("Zipper entries compressed in parallel are read back", "[Zipper]") {
+    const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.zip");
+
+    // Entries below, at and well above the size compressed in parallel blocks, the last not aligned to the block size.
+    const std::vector<std::pair<std::string, std::vector<unsigned char>>> entries {
+        { "small.bin",  make_data(1000, 1) },
+        { "medium.bin", make_data(1024 * 1024, 2) },
+        { "large.bin",  make_data(5 * 1024 * 1024 + 12345, 3) },
+    };
+
+    for (Zipper::e_compression compression : { Zipper::FAST_COMPRESSION, Zipper::TIGHT_COMPRESSION }) {
+        {
+            Zipper zipper(path.string(), compression);
+            for (const auto &[name, data] : entries)
+                zipper.add_entry(name, data.data(), data.size());
+            zipper.finalize();
+        }
+
+        MZ_Archive archive;
+        REQUIRE(open_zip_reader(&archive.arch, path.string()));
+        for (const auto &[name, data] : entries) {
+            INFO(name);
+            const int file_idx = mz_zip_reader_locate_file(&archive.arch, name.c_str(), nullptr, 0);
+            REQUIRE(file_idx >= 0);
+            mz_zip_archive_file_stat stat;
+            REQUIRE(mz_zip_reader_file_stat(&archive.arch, mz_uint(file_idx), &stat));
+            CHECK(stat.m_uncomp_size == data.size());
+            CHECK(stat.m_crc32 == mz_crc32(MZ_CRC32_INIT, data.data(), data.size()));
+            CHECK(stat.m_comp_size < data.size());
+            // Extraction validates the CRC-32 of the inflated data against the one stored in the archive.
+            size_t size     = 0;
+            void  *inflated = mz_zip_reader_extract_to_heap(&archive.arch, mz_uint(file_idx), &size, 0);
+            REQUIRE(inflated != nullptr);
+            const bool same = size == data.size() && std::memcmp(inflated, data.data(), size) == 0;
+            mz_free(inflated);
+            CHECK(same);
+        }
+        close_zip_reader(&archive.arch);
+        boost::filesystem::remove(path);
+    }
+}
@@ -6,10 +6,14 @@
 #include "libslic3r/Format/SLAArchiveFormatRegistry.hpp"
 #include "libslic3r/Format/SLAArchiveWriter.hpp"
 #include "libslic3r/Format/SLAArchiveReader.hpp"
+#include "libslic3r/Format/SL1.hpp"
+#include "libslic3r/miniz_extension.hpp"
 #include "libslic3r/FileReader.hpp"
 
 #include <boost/filesystem.hpp>
 
+#include <cstring>
+
 using namespace Slic3r;
 
 TEST_CASE("Archive export test", "[sla_archives]") {
@@ -69,3 +73,92 @@ TEST_CASE("Archive export test", "[sla_archives]") {
         }
     }
 }
+
+// Rasterizes the layers in memory, the way the layers were rasterized by the slaposRasterize step
+// before the SL1 archive rasterized them while exporting.
+class SL1ArchiveInMemory : public SL1Archive {
+public:
+    using SL1Archive::SL1Archive;
+
+    const std::vector<sla::EncodedRaster>& rasterize(const SLAPrint &print)
+    {
+        draw_layers(print.print_layers().size(),
+            [&print](sla::RasterBase &raster, size_t idx) { print.draw_layer(raster, idx); },
+            []() { return false; });
+        return m_layers;
+    }
+};
+
+TEST_CASE("SL1 archive layers are the same as the layers rasterized in memory", "[sla_archives]") {
+    SLAPrint print;
+    SLAFullPrintConfig fullcfg;
+
+    auto m = FileReader::load_model(TEST_DATA_DIR PATH_SEPARATOR + std::string("extruder_idler") + ".obj");
+
+    fullcfg.printer_technology.setInt(ptSLA);
+    fullcfg.set("sla_archive_format", "SL1");
+    fullcfg.set("supports_enable", false);
+    fullcfg.set("pad_enable", false);
+
+    DynamicPrintConfig cfg;
+    cfg.apply(fullcfg);
+
+    print.set_status_callback([](const PrintBase::SlicingStatus&) {});
+    print.apply(m, cfg);
+    print.process();
+
+    const std::string outputfname = "output_sl1_layers.sl1";
+    print.export_print(outputfname, {}, "layers");
+
+    const std::vector<sla::EncodedRaster> &expected = SL1ArchiveInMemory{ print.printer_config() }.rasterize(print);
+    REQUIRE(! expected.empty());
+
+    MZ_Archive archive;
+    REQUIRE(open_zip_reader(&archive.arch, outputfname));
+    for (size_t idx = 0; idx < expected.size(); ++ idx) {
+        const std::string name = "layers" + string_printf("%.5d", int(idx)) + ".png";
+        INFO(name);
+        size_t size = 0;
+        void  *data = mz_zip_reader_extract_file_to_heap(&archive.arch, name.c_str(), &size, 0);
+        REQUIRE(data != nullptr);
+        const bool same = size == expected[idx].size() && std::memcmp(data, expected[idx].data(), size) == 0;
+        mz_free(data);
+        CHECK(same);
+    }
+    // No more layers were written.
+    const std::string name = "layers" + string_printf("%.5d", int(expected.size())) + ".png";
+    CHECK(mz_zip_reader_locate_file(&archive.arch, name.c_str(), nullptr, 0) < 0);
+    close_zip_reader(&archive.arch);
+    boost::filesystem::remove(outputfname);
+}
+
+TEST_CASE("Exporting an SL1 archive can be canceled", "[sla_archives]") {
+    SLAPrint print;
+    SLAFullPrintConfig fullcfg;
+
+    auto m = FileReader::load_model(TEST_DATA_DIR PATH_SEPARATOR + std::string("20mm_cube") + ".obj");
+
+    fullcfg.printer_technology.setInt(ptSLA);
+    fullcfg.set("sla_archive_format", "SL1");
+    fullcfg.set("supports_enable", false);
+    fullcfg.set("pad_enable", false);
+
+    DynamicPrintConfig cfg;
+    cfg.apply(fullcfg);
+
+    print.apply(m, cfg);
+    print.set_status_callback([](const PrintBase::SlicingStatus&) {});
+    print.process();
+
+    // Cancel the export once it reports its first progress.
+    int num_reported = 0;
+    print.set_status_callback([&print, &num_reported](const PrintBase::SlicingStatus&) {
+        ++ num_reported;
+        print.cancel();
+    });
+    const std::string outputfname = "output_sl1_canceled.sl1";
+    REQUIRE_THROWS_AS(print.export_print(outputfname, {}, "canceled"), CanceledException);
+    CHECK(num_reported > 0);
+    CHECK(size_t(num_reported) < print.print_layers().size());
+    boost::filesystem::remove(outputfname);
+}
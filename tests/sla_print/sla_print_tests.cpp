@@ -2,6 +2,7 @@
 #include <random>
 #include <numeric>
 #include <cstdint>
+#include <cstring>
 
 #include "sla_test_utils.hpp"
 
@@ -103,6 +104,37 @@ TEST_CASE("DefaultSupports::FloorSupportsDoNotPierceModel", "[SLASupportGenerati
         test_support_model_collision(fname, supportcfg);
 }
 
+TEST_CASE("DefaultSupports::RepeatedRunsGiveTheSameTree", "[SLASupportGeneration]") {
+    // All the heads under an elevated cube face the ground, so the tree is
+    // built by the concurrent routing_to_ground() and the serial steps.
+    sla::SupportTreeConfig supportcfg;
+    supportcfg.object_elevation_mm = 10.;
+
+    SupportByproducts first;
+    test_supports("20mm_cube.obj", supportcfg, first);
+
+    const sla::SupportTreeBuilder &tree = first.suptree_builder;
+    const indexed_triangle_set &mesh = tree.retrieve_mesh(sla::MeshType::Support);
+
+    REQUIRE_FALSE(tree.pillars().empty());
+
+    for (int i = 0; i < 3; ++i) {
+        SupportByproducts other;
+        test_supports("20mm_cube.obj", supportcfg, other);
+
+        const sla::SupportTreeBuilder &other_tree = other.suptree_builder;
+        REQUIRE(other_tree.heads().size() == tree.heads().size());
+        REQUIRE(other_tree.pillars().size() == tree.pillars().size());
+        REQUIRE(other_tree.bridges().size() == tree.bridges().size());
+        REQUIRE(other_tree.crossbridges().size() == tree.crossbridges().size());
+
+        const indexed_triangle_set &other_mesh =
+            other_tree.retrieve_mesh(sla::MeshType::Support);
+        REQUIRE(other_mesh.indices == mesh.indices);
+        REQUIRE(other_mesh.vertices == mesh.vertices);
+    }
+}
+
 //TEST_CASE("BranchingSupports::ElevatedSupportGeometryIsValid", "[SLASupportGeneration][Branching]") {
 //    sla::SupportTreeConfig supportcfg;
 //    supportcfg.object_elevation_mm = 10.;
@@ -206,6 +238,52 @@ TEST_CASE("RasterizedPolygonAreaShouldMatch", "[SLARasterOutput]") {
 }
 
 
+TEST_CASE("RunLengthRasterShouldMatchBitmapRaster", "[SLARasterOutput]") {
+    double disp_w = 120., disp_h = 68.;
+    sla::Resolution res{2560, 1440};
+    sla::PixelDim pixdim{disp_w / res.width_px, disp_h / res.height_px};
+    sla::RasterBase::Trafo trafo{sla::RasterBase::roLandscape, sla::RasterBase::MirrorX};
+    auto bb = BoundingBox({0, 0}, {scaled(disp_w), scaled(disp_h)});
+    
+    auto box = [](double x0, double y0, double x1, double y1) {
+        ExPolygon poly;
+        poly.contour.points = {{scaled(x0), scaled(y0)}, {scaled(x1), scaled(y0)},
+                               {scaled(x1), scaled(y1)}, {scaled(x0), scaled(y1)}};
+        return poly;
+    };
+    ExPolygon holed = square_with_hole(10.);
+    holed.rotate(0.3);
+    holed.translate(bb.center().x(), bb.center().y());
+    // Boxes sharing partially covered pixels and a box reaching out of the display.
+    ExPolygons polys = {holed, box(10.013, 5.007, 20.02, 15.3), box(20.02, 5.007, 30.5, 12.1),
+                        box(-5., 60., 7.3, 80.)};
+    
+    auto check = [&](auto gammafn) {
+        sla::RasterGrayscaleAA bitmap(res, pixdim, trafo, gammafn);
+        sla::RasterGrayscaleAARunLength runs(res, pixdim, trafo, gammafn);
+        for (const ExPolygon &poly : polys) {
+            bitmap.draw(poly);
+            runs.draw(poly);
+        }
+        
+        size_t mismatches = 0;
+        for (size_t r = 0; r < res.height_px; ++r)
+            for (size_t c = 0; c < res.width_px; ++c)
+                mismatches += bitmap.read_pixel(c, r) != runs.read_pixel(c, r);
+        REQUIRE(mismatches == 0);
+        REQUIRE(raster_pxsum(bitmap) > 0);
+        
+        sla::EncodedRaster bitmap_png = bitmap.encode(sla::PNGRasterEncoder{});
+        sla::EncodedRaster runs_png   = runs.encode(sla::PNGRasterEncoder{});
+        REQUIRE(bitmap_png.size() == runs_png.size());
+        REQUIRE(std::memcmp(bitmap_png.data(), runs_png.data(), runs_png.size()) == 0);
+    };
+    
+    SECTION("Anti-aliased") { check(agg::gamma_power(1.)); }
+    SECTION("Thresholded") { check(agg::gamma_threshold(.5)); }
+}
+
+
 TEST_CASE("halfcone test", "[halfcone]") {
     sla::DiffBridge br{Vec3d{1., 1., 1.}, Vec3d{10., 10., 10.}, 0.25, 0.5};
 
@@ -225,3 +303,28 @@ TEST_CASE("Test concurrency")
 
     REQUIRE(s == Approx(ref));
 }
+
+TEST_CASE("Interior generated from a reused distance grid", "[Hollowing]")
+{
+    TriangleMesh mesh = load_model("20mm_cube.obj");
+    auto csgmesh = std::array{ csg::CSGPart{&mesh.its} };
+    
+    sla::HollowingConfig hcfg;
+    double voxel_scale = sla::get_voxel_scale(sla::csgmesh_positive_maxvolume(range(csgmesh)), hcfg);
+    VoxelGridPtr grid = sla::generate_interior_grid(range(csgmesh), voxel_scale);
+    REQUIRE(grid);
+    
+    // Only the thickness and the closing distance change, the voxel scale depends on the quality.
+    for (double thickness : {2., 3.})
+        for (double closing_distance : {0., 1.}) {
+            hcfg.min_thickness    = thickness;
+            hcfg.closing_distance = closing_distance;
+            
+            sla::InteriorPtr reused = sla::generate_interior(*grid, hcfg);
+            sla::InteriorPtr fresh  = sla::generate_interior(mesh.its, hcfg);
+            REQUIRE(reused);
+            REQUIRE(fresh);
+            REQUIRE(sla::get_mesh(*reused).vertices.size() == sla::get_mesh(*fresh).vertices.size());
+            REQUIRE(its_volume(sla::get_mesh(*reused)) == Approx(its_volume(sla::get_mesh(*fresh))));
+        }
+}